@@ -6,6 +6,13 @@
 #include <array>
 #include <ranges>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cmath>
+#include <concepts>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 using namespace std::literals;
 
@@ -105,21 +112,220 @@ constexpr int fibonacci(int n)
     return fibonacci(n-1) + fibonacci(n-2);
 }
 
-template <size_t N, typename F>
-consteval auto create_lookup_table(F func)
+// fast doubling: F(2k) = F(k) * (2F(k+1) - F(k)), F(2k+1) = F(k)^2 + F(k+1)^2 - O(log n) instead of O(phi^n)
+template <std::unsigned_integral T>
+    requires (sizeof(T) >= sizeof(unsigned))
+constexpr T fibonacci_doubling(uint64_t n)
 {
-    std::array<uintmax_t, N> values{};
+    T a = 0, b = 1; // F(k), F(k+1)
+
+    for (int bit = std::bit_width(n) - 1; bit >= 0; --bit)
+    {
+        const T f_2k = a * (2 * b - a);
+        const T f_2k_1 = a * a + b * b;
+
+        a = (n >> bit) & 1 ? f_2k_1 : f_2k;
+        b = (n >> bit) & 1 ? f_2k + f_2k_1 : f_2k_1;
+    }
 
-    auto func_values = 
-        std::views::iota(0)
-        | std::views::take(N)
-        | std::views::transform([func](auto n) { return func(n); });
+    return a;
+}
 
-    std::ranges::copy(func_values, values.begin());
+template <size_t N, typename T = uintmax_t, typename F>
+consteval auto create_lookup_table(F func)
+{
+    std::array<T, N> values{};
+
+    for (size_t i = 0; i < N; ++i)
+        values[i] = static_cast<T>(func(i));
 
     return values;
 }
 
+namespace LookupTables
+{
+    // func(key) for key in {first, first + stride, ..., first + (N - 1) * stride},
+    // any other key is computed at runtime
+    template <typename T, size_t N, std::integral Key, typename F>
+    class StridedTable
+    {
+        Key first_;
+        Key stride_;
+        std::array<T, N> values_{};
+        F func_;
+
+    public:
+        consteval StridedTable(F func, Key first, Key stride)
+            : first_{first}
+            , stride_{stride}
+            , func_{func}
+        {
+            if (stride <= 0)
+                throw std::invalid_argument("stride must be positive");
+
+            for (size_t i = 0; i < N; ++i)
+                values_[i] = static_cast<T>(func(static_cast<Key>(first + static_cast<Key>(i) * stride)));
+        }
+
+        constexpr std::optional<size_t> index_of(Key key) const
+        {
+            if (key < first_)
+                return std::nullopt;
+
+            const auto offset = static_cast<std::make_unsigned_t<Key>>(key - first_);
+            const auto stride = static_cast<std::make_unsigned_t<Key>>(stride_);
+            if (offset % stride != 0 || offset / stride >= N)
+                return std::nullopt;
+
+            return offset / stride;
+        }
+
+        constexpr bool contains(Key key) const
+        {
+            return index_of(key).has_value();
+        }
+
+        constexpr T operator()(Key key) const
+        {
+            if (const auto index = index_of(key))
+                return values_[*index];
+
+            return static_cast<T>(func_(key));
+        }
+
+        constexpr const std::array<T, N>& values() const
+        {
+            return values_;
+        }
+    };
+
+    template <size_t N, typename T = void, std::integral Key, typename F>
+    consteval auto make_strided_table(F func, Key first, Key stride = 1)
+    {
+        using Value = std::conditional_t<std::is_void_v<T>, std::invoke_result_t<F, Key>, T>;
+        return StridedTable<Value, N, Key, F>{func, first, stride};
+    }
+
+    // N equidistant samples of func on [low, high] - values in between are linearly interpolated,
+    // values outside of the interval are computed at runtime
+    template <std::floating_point T, size_t N, typename F>
+        requires (N >= 2)
+    class InterpolatedTable
+    {
+        T low_;
+        T high_;
+        T step_;
+        std::array<T, N> samples_{};
+        F func_;
+
+    public:
+        consteval InterpolatedTable(F func, T low, T high)
+            : low_{low}
+            , high_{high}
+            , step_{(high - low) / (N - 1)}
+            , func_{func}
+        {
+            if (!(low < high))
+                throw std::invalid_argument("empty interval");
+
+            for (size_t i = 0; i < N; ++i)
+                samples_[i] = static_cast<T>(func(low + static_cast<T>(i) * step_));
+        }
+
+        constexpr bool contains(T x) const
+        {
+            return low_ <= x && x <= high_;
+        }
+
+        constexpr T operator()(T x) const
+        {
+            if (!contains(x))
+                return static_cast<T>(func_(x));
+
+            const T position = (x - low_) / step_;
+            const size_t index = std::min(static_cast<size_t>(position), N - 2);
+            const T fraction = position - static_cast<T>(index);
+
+            return samples_[index] + fraction * (samples_[index + 1] - samples_[index]);
+        }
+
+        // largest |table(x) - func(x)| over probes points between the samples
+        constexpr T max_error(size_t probes_per_step = 8) const
+        {
+            T error = 0;
+            for (size_t i = 0; i < (N - 1) * probes_per_step; ++i)
+            {
+                const T x = low_ + step_ * static_cast<T>(i) / static_cast<T>(probes_per_step);
+                const T difference = (*this)(x) - static_cast<T>(func_(x));
+                error = std::max(error, difference < 0 ? -difference : difference);
+            }
+            return error;
+        }
+    };
+
+    template <size_t N, std::floating_point T, typename F>
+    consteval auto make_interpolated_table(F func, T low, T high)
+    {
+        return InterpolatedTable<T, N, F>{func, low, high};
+    }
+
+    // func(key) for an arbitrary set of keys - sorted at compile time, binary search at runtime
+    template <typename T, size_t N, typename Key, typename F>
+    class SparseTable
+    {
+        std::array<Key, N> keys_{};
+        std::array<T, N> values_{};
+        F func_;
+
+    public:
+        consteval SparseTable(F func, std::array<Key, N> keys)
+            : keys_{keys}
+            , func_{func}
+        {
+            std::ranges::sort(keys_);
+            if (std::ranges::adjacent_find(keys_) != keys_.end())
+                throw std::invalid_argument("duplicated key");
+
+            for (size_t i = 0; i < N; ++i)
+                values_[i] = static_cast<T>(func(keys_[i]));
+        }
+
+        constexpr const T* find(const Key& key) const
+        {
+            const auto it = std::ranges::lower_bound(keys_, key);
+            if (it == keys_.end() || *it != key)
+                return nullptr;
+
+            return &values_[it - keys_.begin()];
+        }
+
+        constexpr bool contains(const Key& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        constexpr T operator()(const Key& key) const
+        {
+            if (const T* value = find(key))
+                return *value;
+
+            return static_cast<T>(func_(key));
+        }
+
+        constexpr const std::array<Key, N>& keys() const
+        {
+            return keys_;
+        }
+    };
+
+    template <typename T = void, typename Key, size_t N, typename F>
+    consteval auto make_sparse_table(F func, const Key (&keys)[N])
+    {
+        using Value = std::conditional_t<std::is_void_v<T>, std::invoke_result_t<F, Key>, T>;
+        return SparseTable<Value, N, Key, F>{func, std::to_array(keys)};
+    }
+} // namespace LookupTables
+
 constexpr int fast_fibonacci(int n)
 {
     constexpr auto lookup_fib = create_lookup_table<20>(fibonacci);
@@ -129,7 +335,7 @@ constexpr int fast_fibonacci(int n)
         return lookup_fib[n];
     }
     else
-        return fibonacci(n);
+        return static_cast<int>(fibonacci_doubling<uint64_t>(n));
 }
 
 TEST_CASE("lookup tables")
@@ -141,4 +347,85 @@ TEST_CASE("lookup tables")
     constexpr auto lookup_table = create_lookup_table<20>(fibonacci);
 
     static_assert(fast_fibonacci(10) == 55);
+    static_assert(fast_fibonacci(40) == 102'334'155);
+
+    constexpr auto squares = create_lookup_table<10, uint8_t>([](size_t n) { return n * n; });
+    static_assert(std::same_as<decltype(squares), const std::array<uint8_t, 10>>);
+    static_assert(squares[9] == 81);
+}
+
+namespace
+{
+    constexpr int64_t polynomial(int64_t x)
+    {
+        return 3 * x * x * x - 2 * x + 7;
+    }
+
+    // e^x as a constexpr series - the kind of call we want to replace with a table
+    constexpr double exp_series(double x)
+    {
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 40; ++n)
+        {
+            term *= x / n;
+            sum += term;
+        }
+        return sum;
+    }
+} // namespace
+
+TEST_CASE("lookup table engine")
+{
+    using namespace LookupTables;
+
+    SECTION("strided domain with chosen element type")
+    {
+        constexpr auto table = make_strided_table<100, int32_t>(polynomial, int64_t{-50}, int64_t{5});
+
+        static_assert(sizeof(table.values()) == 100 * sizeof(int32_t));
+        static_assert(table.contains(-50) && table.contains(445));
+        static_assert(!table.contains(-49) && !table.contains(450));
+        static_assert(table(-50) == polynomial(-50));
+        static_assert(table(445) == polynomial(445));
+
+        for (int64_t x = -60; x < 500; ++x)
+            REQUIRE(table(x) == polynomial(x)); // outside of the domain - computed at runtime
+    }
+
+    SECTION("interpolated table of a floating point function")
+    {
+        constexpr auto table = make_interpolated_table<257>(exp_series, 0.0, 1.0);
+
+        static_assert(table(0.0) == exp_series(0.0));
+        static_assert(table(1.0) - exp_series(1.0) < 1e-12);
+        static_assert(table.max_error() < 1e-5);
+
+        CHECK(std::abs(table(0.123456) - std::exp(0.123456)) < 1e-5);
+        CHECK(table(2.0) == exp_series(2.0)); // outside of [low, high]
+        CHECK(table(-0.5) == exp_series(-0.5));
+    }
+
+    SECTION("sparse keyed table")
+    {
+        constexpr auto table = make_sparse_table([](int n) { return fibonacci_doubling<uint64_t>(n); }, {90, 10, 50, 93, 1});
+
+        static_assert(table.keys() == std::array{1, 10, 50, 90, 93});
+        static_assert(table(93) == 12'200'160'415'121'876'738ULL);
+        static_assert(table.find(11) == nullptr);
+
+        REQUIRE(table(10) == 55);
+        REQUIRE(table(11) == 89);
+    }
+}
+
+TEST_CASE("fast doubling fibonacci")
+{
+    static_assert(fibonacci_doubling<uint32_t>(0) == 0);
+    static_assert(fibonacci_doubling<uint32_t>(1) == 1);
+    static_assert(fibonacci_doubling<uint32_t>(47) == 2'971'215'073);
+    static_assert(fibonacci_doubling<uint64_t>(93) == 12'200'160'415'121'876'738ULL);
+
+    for (int n = 0; n < 25; ++n)
+        REQUIRE(fibonacci_doubling<uint64_t>(n) == static_cast<uint64_t>(fibonacci(n)));
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+#ifndef ASYNC_LOG_HPP
+#define ASYNC_LOG_HPP
+
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace helpers::log
+{
+    enum class Level : uint8_t
+    {
+        trace,
+        debug,
+        info,
+        warning,
+        error,
+        off
+    };
+
+    constexpr std::string_view to_string(Level level)
+    {
+        constexpr std::string_view names[] = {"trace", "debug", "info", "warning", "error", "off"};
+        return names[static_cast<size_t>(level)];
+    }
+
+    // single producer, single consumer byte queue - head is written only by the producer, tail only by
+    // the consumer, each on its own cache line; the producer caches tail to avoid touching the consumer's line
+    class SpscRing
+    {
+        static constexpr size_t cache_line = 64;
+
+        std::unique_ptr<char[]> buffer_;
+        size_t capacity_;
+
+        alignas(cache_line) std::atomic<size_t> head_{0};
+        size_t cached_tail_ = 0;
+
+        alignas(cache_line) std::atomic<size_t> tail_{0};
+
+    public:
+        explicit SpscRing(size_t capacity)
+            : buffer_{std::make_unique<char[]>(std::bit_ceil(capacity))}
+            , capacity_{std::bit_ceil(capacity)}
+        {
+        }
+
+        size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        // all bytes or nothing
+        bool try_push(std::string_view bytes)
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+
+            if (capacity_ - (head - cached_tail_) < bytes.size())
+            {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (capacity_ - (head - cached_tail_) < bytes.size())
+                    return false;
+            }
+
+            const size_t offset = head & (capacity_ - 1);
+            const size_t first_part = std::min(bytes.size(), capacity_ - offset);
+            std::memcpy(buffer_.get() + offset, bytes.data(), first_part);
+            std::memcpy(buffer_.get(), bytes.data() + first_part, bytes.size() - first_part);
+
+            head_.store(head + bytes.size(), std::memory_order_release);
+            return true;
+        }
+
+        // passes everything pushed so far to consume (in up to two contiguous pieces), returns the byte count
+        template <typename Consume>
+        size_t drain(Consume&& consume)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            const size_t head = head_.load(std::memory_order_acquire);
+            if (head == tail)
+                return 0;
+
+            const size_t offset = tail & (capacity_ - 1);
+            const size_t size = head - tail;
+            const size_t first_part = std::min(size, capacity_ - offset);
+            consume(std::string_view{buffer_.get() + offset, first_part});
+            if (first_part < size)
+                consume(std::string_view{buffer_.get(), size - first_part});
+
+            tail_.store(head, std::memory_order_release);
+            return size;
+        }
+
+        bool empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+    };
+
+    struct AsyncBackendOptions
+    {
+        int fd = 1;                                           // target file descriptor (1 - stdout)
+        size_t ring_capacity = 64 * 1024;                     // bytes per producing thread
+        std::chrono::microseconds flush_interval{1'000};      // how long the flusher sleeps when there is nothing to write
+    };
+
+    // every producing thread gets its own SpscRing, a background thread moves their contents into one
+    // batch written with a single write() call; a producer finding its ring full drains the rings itself
+    // (the drain mutex keeps one consumer at a time), so messages are never dropped
+    class AsyncBackend
+    {
+        struct ThreadRing
+        {
+            SpscRing ring;
+            std::atomic<bool> owner_alive{true};
+
+            explicit ThreadRing(size_t capacity)
+                : ring{capacity}
+            {
+            }
+        };
+
+        // rings of the current thread - one per backend the thread has written to
+        struct ThreadRings
+        {
+            std::vector<std::pair<uint64_t, std::shared_ptr<ThreadRing>>> rings;
+
+            ~ThreadRings()
+            {
+                for (auto& [backend_id, ring] : rings)
+                    ring->owner_alive = false;
+            }
+        };
+
+        static inline std::atomic<uint64_t> next_id_{1};
+
+        AsyncBackendOptions options_;
+        uint64_t id_ = next_id_++;
+
+        std::mutex rings_mutex_;
+        std::vector<std::shared_ptr<ThreadRing>> rings_;
+
+        std::mutex drain_mutex_;
+        std::string batch_;
+        std::atomic<uint64_t> bytes_written_{0};
+
+        std::condition_variable_any wake_up_;
+        std::jthread flusher_;
+
+    public:
+        explicit AsyncBackend(AsyncBackendOptions options = {})
+            : options_{options}
+            , flusher_{[this](std::stop_token stop) { run_flusher(stop); }}
+        {
+        }
+
+        AsyncBackend(const AsyncBackend&) = delete;
+        AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+        ~AsyncBackend()
+        {
+            flusher_.request_stop();
+            flusher_.join();
+            flush();
+        }
+
+        // shared backend writing to stdout
+        static AsyncBackend& standard_output()
+        {
+            static AsyncBackend backend{};
+            return backend;
+        }
+
+        // bytes longer than the ring capacity bypass the ring - they are written synchronously
+        // after everything queued before, so the order of messages of a thread is kept
+        void write(std::string_view bytes)
+        {
+            SpscRing& ring = local_ring();
+            if (bytes.size() > ring.capacity())
+            {
+                write_direct(bytes);
+                return;
+            }
+
+            while (!ring.try_push(bytes))
+                flush();
+        }
+
+        // everything written (by any thread) before the call is passed to the file descriptor;
+        // returns the number of bytes this call wrote
+        size_t flush()
+        {
+            std::lock_guard lock{drain_mutex_};
+            return drain_all();
+        }
+
+        uint64_t bytes_written() const
+        {
+            return bytes_written_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        SpscRing& local_ring()
+        {
+            thread_local ThreadRings thread_rings;
+
+            for (auto& [backend_id, ring] : thread_rings.rings)
+            {
+                if (backend_id == id_)
+                    return ring->ring;
+            }
+
+            auto ring = std::make_shared<ThreadRing>(options_.ring_capacity);
+            {
+                std::lock_guard lock{rings_mutex_};
+                rings_.push_back(ring);
+            }
+            thread_rings.rings.emplace_back(id_, ring);
+
+            return ring->ring;
+        }
+
+        // requires drain_mutex_; rings_mutex_ is released before the write - a thread registering its ring
+        // does not wait for a slow file descriptor; returns the number of bytes written
+        size_t drain_all()
+        {
+            batch_.clear();
+
+            {
+                std::lock_guard lock{rings_mutex_};
+                std::erase_if(rings_, [this](const std::shared_ptr<ThreadRing>& thread_ring) {
+                    const bool owner_alive = thread_ring->owner_alive.load(std::memory_order_acquire);
+                    thread_ring->ring.drain([this](std::string_view bytes) { batch_.append(bytes); });
+                    return !owner_alive; // drained after the owner's last write
+                });
+            }
+
+            if (!batch_.empty())
+            {
+                details::write_all(options_.fd, batch_);
+                bytes_written_.fetch_add(batch_.size(), std::memory_order_relaxed);
+            }
+
+            return batch_.size();
+        }
+
+        void write_direct(std::string_view bytes)
+        {
+            std::lock_guard lock{drain_mutex_};
+            drain_all();
+
+            details::write_all(options_.fd, bytes);
+            bytes_written_.fetch_add(bytes.size(), std::memory_order_relaxed);
+        }
+
+        // drains again right away while there is something to write, sleeps only when the rings were empty
+        void run_flusher(std::stop_token stop)
+        {
+            std::mutex wait_mutex;
+            while (!stop.stop_requested())
+            {
+                if (flush() > 0)
+                    continue;
+
+                std::unique_lock lock{wait_mutex};
+                wake_up_.wait_for(lock, stop, options_.flush_interval, [] { return false; });
+            }
+        }
+    };
+} // namespace helpers::log
+
+#endif
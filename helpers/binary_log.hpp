@@ -0,0 +1,492 @@
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include "async_log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+// Binary log stream (native byte order):
+//   header: "HLOG" version:u8
+//   site record:  kind=0:u8 id:u32 level:u8 logger_size:u16 logger format_size:u16 format arg_count:u8 arg_types:u8[]
+//   event record: kind=1:u8 site_id:u32 payload_size:u32 payload
+// Every call site (level, logger, format, argument types) is registered once and described by a site record,
+// events carry only raw argument bytes - numbers as 8 bytes, bool & char as 1 byte, strings as size:u32 + chars.
+// A site record may follow the first events of its site (rings of different threads are drained in any order).
+
+namespace helpers::log
+{
+    template <size_t N>
+    struct FixedString
+    {
+        char text[N];
+
+        constexpr FixedString(const char (&str)[N]) noexcept
+        {
+            std::copy(str, str + N, text);
+        }
+
+        constexpr std::string_view view() const noexcept
+        {
+            return {text, N - 1};
+        }
+    };
+
+    enum class ArgType : uint8_t
+    {
+        boolean,
+        character,
+        signed_integer,
+        unsigned_integer,
+        floating_point,
+        string
+    };
+
+    namespace details
+    {
+        // how an argument is stored and restored by the decoder
+        template <typename T>
+        struct BinaryArg;
+
+        template <>
+        struct BinaryArg<bool>
+        {
+            using DecodedType = bool;
+            static constexpr ArgType type = ArgType::boolean;
+        };
+
+        template <>
+        struct BinaryArg<char>
+        {
+            using DecodedType = char;
+            static constexpr ArgType type = ArgType::character;
+        };
+
+        template <typename T>
+            requires std::signed_integral<T> && (!std::same_as<T, char>)
+        struct BinaryArg<T>
+        {
+            using DecodedType = int64_t;
+            static constexpr ArgType type = ArgType::signed_integer;
+        };
+
+        template <typename T>
+            requires std::unsigned_integral<T> && (!std::same_as<T, bool>) && (!std::same_as<T, char>)
+        struct BinaryArg<T>
+        {
+            using DecodedType = uint64_t;
+            static constexpr ArgType type = ArgType::unsigned_integer;
+        };
+
+        template <std::floating_point T>
+        struct BinaryArg<T>
+        {
+            using DecodedType = double;
+            static constexpr ArgType type = ArgType::floating_point;
+        };
+
+        template <typename T>
+            requires(!std::is_arithmetic_v<T>) && std::convertible_to<const T&, std::string_view>
+        struct BinaryArg<T>
+        {
+            using DecodedType = std::string_view;
+            static constexpr ArgType type = ArgType::string;
+        };
+
+        template <typename T>
+        using BinaryArgOf = BinaryArg<std::decay_t<T>>;
+
+        template <typename T>
+        size_t encoded_size(const T& arg)
+        {
+            if constexpr (BinaryArgOf<T>::type == ArgType::string)
+                return sizeof(uint32_t) + std::string_view{arg}.size();
+            else if constexpr (BinaryArgOf<T>::type == ArgType::boolean || BinaryArgOf<T>::type == ArgType::character)
+                return 1;
+            else
+                return 8;
+        }
+
+        template <typename T>
+        char* put(char* out, const T& value)
+        {
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+
+        template <typename T>
+        char* encode(char* out, const T& arg)
+        {
+            using Decoded = typename BinaryArgOf<T>::DecodedType;
+
+            if constexpr (std::same_as<Decoded, std::string_view>)
+            {
+                const std::string_view text{arg};
+                out = put(out, static_cast<uint32_t>(text.size()));
+                std::memcpy(out, text.data(), text.size());
+                return out + text.size();
+            }
+            else
+                return put(out, static_cast<Decoded>(arg));
+        }
+
+        template <typename T>
+        T get(std::string_view& in)
+        {
+            if (in.size() < sizeof(T))
+                throw std::runtime_error("binary log: truncated record");
+
+            T value;
+            std::memcpy(&value, in.data(), sizeof(T));
+            in.remove_prefix(sizeof(T));
+            return value;
+        }
+
+        inline std::string_view get_text(std::string_view& in, size_t size)
+        {
+            if (in.size() < size)
+                throw std::runtime_error("binary log: truncated record");
+
+            const std::string_view text = in.substr(0, size);
+            in.remove_prefix(size);
+            return text;
+        }
+
+        constexpr std::string_view header = "HLOG\x01";
+
+        enum class RecordKind : uint8_t
+        {
+            site,
+            event
+        };
+
+        struct Site
+        {
+            Level level;
+            std::string_view logger;
+            std::string_view format;
+            std::span<const ArgType> arg_types;
+        };
+
+        template <typename... TArgs>
+        inline constexpr std::array<ArgType, sizeof...(TArgs)> arg_types = {BinaryArgOf<TArgs>::type...};
+
+        // every call site of the process - ids are indexes
+        class SiteRegistry
+        {
+            std::mutex mutex_;
+            std::deque<Site> sites_;
+            std::atomic<uint32_t> size_{0};
+
+        public:
+            static SiteRegistry& instance()
+            {
+                static SiteRegistry registry;
+                return registry;
+            }
+
+            uint32_t add(const Site& site)
+            {
+                std::lock_guard lock{mutex_};
+                sites_.push_back(site);
+                size_.store(static_cast<uint32_t>(sites_.size()), std::memory_order_release);
+                return static_cast<uint32_t>(sites_.size() - 1);
+            }
+
+            uint32_t size() const
+            {
+                return size_.load(std::memory_order_acquire);
+            }
+
+            Site operator[](uint32_t id)
+            {
+                std::lock_guard lock{mutex_};
+                return sites_[id];
+            }
+        };
+
+        // "{:{}}" - dynamic width or precision taken from another argument
+        // (plain indexing - GCC 12 cannot constant-evaluate string_view::find on template parameter objects)
+        constexpr bool has_nested_replacement_field(std::string_view format)
+        {
+            bool in_field = false;
+
+            for (size_t pos = 0; pos < format.size(); ++pos)
+            {
+                if (format[pos] == '{')
+                {
+                    if (in_field)
+                        return true;
+
+                    if (pos + 1 < format.size() && format[pos + 1] == '{')
+                        ++pos;
+                    else
+                        in_field = true;
+                }
+                else if (format[pos] == '}')
+                    in_field = false;
+            }
+
+            return false;
+        }
+
+        template <Level MessageLevel, FixedString Logger, FixedString Format, typename... TArgs>
+        uint32_t site_id()
+        {
+            static const uint32_t id = SiteRegistry::instance().add({MessageLevel, Logger.view(), Format.view(), arg_types<TArgs...>});
+            return id;
+        }
+
+        inline void append_site(std::string& out, uint32_t id, const Site& site)
+        {
+            const auto put_value = [&out](auto value) { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+            put_value(RecordKind::site);
+            put_value(id);
+            put_value(site.level);
+            put_value(static_cast<uint16_t>(site.logger.size()));
+            out += site.logger;
+            put_value(static_cast<uint16_t>(site.format.size()));
+            out += site.format;
+            put_value(static_cast<uint8_t>(site.arg_types.size()));
+            for (ArgType type : site.arg_types)
+                put_value(type);
+        }
+    } // namespace details
+
+    template <typename T>
+    concept BinaryLoggable = requires { details::BinaryArgOf<T>::type; };
+
+    // log calls that copy only a site id and the raw argument bytes - formatting is deferred to decode_binary_log()
+    class BinaryLog
+    {
+        AsyncBackend backend_;
+        std::mutex announce_mutex_;
+        std::atomic<uint32_t> announced_sites_{0};
+
+    public:
+        explicit BinaryLog(AsyncBackendOptions options)
+            : backend_{options}
+        {
+            helpers::details::write_all(options.fd, details::header);
+        }
+
+        // the format string is checked against the argument types at compile time (without nested replacement fields);
+        // records longer than the ring of the calling thread are written synchronously
+        template <Level MessageLevel, FixedString Logger, FixedString Format, BinaryLoggable... TArgs>
+        void write(const TArgs&... args)
+        {
+            [[maybe_unused]] constexpr std::format_string<typename details::BinaryArgOf<TArgs>::DecodedType...> checked_format{Format.view()};
+            static_assert(!details::has_nested_replacement_field(Format.view()), "nested replacement fields are not supported by the decoder");
+
+            const uint32_t id = details::site_id<MessageLevel, Logger, Format, std::decay_t<TArgs>...>();
+            if (id >= announced_sites_.load(std::memory_order_acquire))
+                announce_sites();
+
+            const size_t payload_size = (size_t{0} + ... + details::encoded_size(args));
+
+            thread_local std::string record;
+            record.resize(sizeof(details::RecordKind) + sizeof(uint32_t) + sizeof(uint32_t) + payload_size);
+
+            char* out = record.data();
+            out = details::put(out, details::RecordKind::event);
+            out = details::put(out, id);
+            out = details::put(out, static_cast<uint32_t>(payload_size));
+            ((out = details::encode(out, args)), ...);
+
+            backend_.write(record);
+        }
+
+        void flush()
+        {
+            backend_.flush();
+        }
+
+    private:
+        // writes site records not yet seen by this log - before the event of the calling thread
+        void announce_sites()
+        {
+            std::lock_guard lock{announce_mutex_};
+
+            auto& registry = details::SiteRegistry::instance();
+            const uint32_t first = announced_sites_.load(std::memory_order_relaxed);
+            const uint32_t last = registry.size();
+
+            std::string records;
+            for (uint32_t id = first; id < last; ++id)
+                details::append_site(records, id, registry[id]);
+
+            backend_.write(records);
+            announced_sites_.store(last, std::memory_order_release);
+        }
+    };
+
+    namespace details
+    {
+        using DecodedArg = std::variant<bool, char, int64_t, uint64_t, double, std::string_view>;
+
+        inline DecodedArg decode_arg(ArgType type, std::string_view& payload)
+        {
+            switch (type)
+            {
+            case ArgType::boolean:
+                return get<bool>(payload);
+            case ArgType::character:
+                return get<char>(payload);
+            case ArgType::signed_integer:
+                return get<int64_t>(payload);
+            case ArgType::unsigned_integer:
+                return get<uint64_t>(payload);
+            case ArgType::floating_point:
+                return get<double>(payload);
+            case ArgType::string:
+                return get_text(payload, get<uint32_t>(payload));
+            }
+
+            throw std::runtime_error("binary log: unknown argument type");
+        }
+
+        // replacement fields are formatted one at a time: "{index:spec}" -> "{:spec}" with the selected argument
+        // (nested replacement fields - dynamic width or precision - are rejected by BinaryLog::write);
+        // the format comes from the log file - malformed fields throw instead of reading past the arguments
+        inline void format_event(std::string& out, std::string_view format, std::span<const DecodedArg> args)
+        {
+            size_t next_arg = 0;
+
+            for (size_t pos = 0; pos < format.size(); ++pos)
+            {
+                const char c = format[pos];
+
+                if ((c == '{' || c == '}') && pos + 1 < format.size() && format[pos + 1] == c)
+                {
+                    out += c;
+                    ++pos;
+                    continue;
+                }
+
+                if (c == '}')
+                    throw std::runtime_error("binary log: unmatched '}' in format");
+
+                if (c != '{')
+                {
+                    out += c;
+                    continue;
+                }
+
+                const size_t end = format.find('}', pos);
+                if (end == std::string_view::npos)
+                    throw std::runtime_error("binary log: unterminated replacement field");
+
+                const std::string_view field = format.substr(pos + 1, end - pos - 1);
+                const size_t colon = field.find(':');
+                const std::string_view index = field.substr(0, colon);
+
+                if (field.find('{') != std::string_view::npos)
+                    throw std::runtime_error("binary log: nested replacement fields are not supported");
+
+                size_t arg = next_arg++;
+                if (!index.empty())
+                {
+                    const auto [last, error] = std::from_chars(index.data(), index.data() + index.size(), arg);
+                    if (error != std::errc{} || last != index.data() + index.size())
+                        throw std::runtime_error("binary log: invalid argument index");
+                }
+
+                if (arg >= args.size())
+                    throw std::runtime_error("binary log: argument index out of range");
+
+                const std::string spec = std::string{"{"} + std::string{colon == std::string_view::npos ? "" : field.substr(colon)} + "}";
+                std::visit([&](const auto& value) { out += std::vformat(spec, std::make_format_args(value)); }, args[arg]);
+
+                pos = end;
+            }
+        }
+    } // namespace details
+
+    // turns a binary log back into "[level] logger: message" lines
+    inline void decode_binary_log(std::string_view log, std::ostream& out)
+    {
+        using namespace details;
+
+        if (!log.starts_with(header))
+            throw std::runtime_error("binary log: missing header");
+        log.remove_prefix(header.size());
+
+        struct Event
+        {
+            uint32_t site_id;
+            std::string_view payload;
+        };
+
+        std::unordered_map<uint32_t, Site> sites;
+        std::deque<std::vector<ArgType>> site_arg_types;
+        std::vector<Event> events;
+
+        while (!log.empty())
+        {
+            if (get<RecordKind>(log) == RecordKind::site)
+            {
+                const auto id = get<uint32_t>(log);
+                Site site;
+                site.level = get<Level>(log);
+                site.logger = get_text(log, get<uint16_t>(log));
+                site.format = get_text(log, get<uint16_t>(log));
+
+                auto& arg_types = site_arg_types.emplace_back(get<uint8_t>(log));
+                for (auto& type : arg_types)
+                    type = get<ArgType>(log);
+                site.arg_types = arg_types;
+
+                sites.emplace(id, site);
+            }
+            else
+            {
+                const auto site_id = get<uint32_t>(log);
+                events.push_back({site_id, get_text(log, get<uint32_t>(log))});
+            }
+        }
+
+        std::string line;
+        std::vector<DecodedArg> args;
+        for (auto [site_id, payload] : events)
+        {
+            const auto site = sites.find(site_id);
+            if (site == sites.end())
+                throw std::runtime_error(std::format("binary log: unknown site {}", site_id));
+
+            args.clear();
+            for (ArgType type : site->second.arg_types)
+                args.push_back(decode_arg(type, payload));
+
+            if (!payload.empty())
+                throw std::runtime_error("binary log: payload longer than the arguments of its site");
+
+            line.clear();
+            std::format_to(std::back_inserter(line), "[{}] {}: ", to_string(site->second.level), site->second.logger);
+            format_event(line, site->second.format, args);
+            line += '\n';
+
+            out << line;
+        }
+    }
+} // namespace helpers::log
+
+#endif
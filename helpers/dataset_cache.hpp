@@ -0,0 +1,454 @@
+#ifndef DATASET_CACHE_HPP
+#define DATASET_CACHE_HPP
+
+#include "helpers.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HELPERS_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace helpers
+{
+    // bump whenever fill_numeric_dataset produces different values for the same parameters -
+    // cache files written by an older generator are then ignored and can be purged
+    inline constexpr uint32_t dataset_generator_version = 2;
+
+    namespace details
+    {
+        inline constexpr std::array<char, 8> dataset_file_magic = {'H', 'D', 'S', 'C', 'A', 'C', 'H', 'E'};
+        inline constexpr uint32_t dataset_file_format_version = 1;
+        inline constexpr size_t dataset_payload_offset = 64;
+
+        struct DatasetFileHeader
+        {
+            std::array<char, 8> magic = dataset_file_magic;
+            uint32_t format_version = dataset_file_format_version;
+            uint32_t generator_version = dataset_generator_version;
+            uint32_t element_type = 0;
+            uint32_t reserved = 0;
+            uint64_t seed = 0;
+            uint64_t size = 0;
+            uint64_t low = 0;
+            uint64_t high = 0;
+            uint64_t checksum = 0;
+
+            bool operator==(const DatasetFileHeader&) const = default;
+        };
+
+        static_assert(sizeof(DatasetFileHeader) <= dataset_payload_offset);
+        static_assert(std::is_trivially_copyable_v<DatasetFileHeader>);
+
+        inline uint64_t process_id()
+        {
+#ifdef HELPERS_HAS_MMAP
+            return static_cast<uint64_t>(::getpid());
+#else
+            static const uint64_t id = std::random_device{}();
+            return id;
+#endif
+        }
+
+        // size | floating point flag | signed flag
+        template <NumericDatasetElement T>
+        constexpr uint32_t dataset_element_type = sizeof(T) | (std::floating_point<T> ? 0x100 : 0) | (std::is_signed_v<T> ? 0x200 : 0);
+
+        template <NumericDatasetElement T>
+        constexpr uint64_t dataset_bound_bits(T value)
+        {
+            if constexpr (std::floating_point<T>)
+                return std::bit_cast<uint64_t>(static_cast<double>(value));
+            else
+                return static_cast<uint64_t>(value);
+        }
+
+        // 4 independent multiply-xorshift lanes over 64-bit words - fast enough to verify GBs when requested
+        inline uint64_t dataset_checksum(std::span<const std::byte> bytes)
+        {
+            constexpr uint64_t prime = 0x9E37'79B9'7F4A'7C15ULL;
+
+            std::array<uint64_t, 4> acc = {0x243F'6A88'85A3'08D3ULL, 0x1319'8A2E'0370'7344ULL, 0xA409'3822'299F'31D0ULL, 0x082E'FA98'EC4E'6C89ULL};
+
+            auto mix = [](uint64_t h, uint64_t word) {
+                h ^= word;
+                h *= prime;
+                return h ^ (h >> 29);
+            };
+
+            const size_t words = bytes.size() / sizeof(uint64_t);
+            for (size_t i = 0; i + 4 <= words; i += 4)
+            {
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, bytes.data() + (i + lane) * sizeof(uint64_t), sizeof(word));
+                    acc[lane] = mix(acc[lane], word);
+                }
+            }
+
+            uint64_t result = bytes.size();
+            for (uint64_t lane_acc : acc)
+                result = mix(result, lane_acc);
+
+            for (size_t i = words / 4 * 4 * sizeof(uint64_t); i < bytes.size(); ++i)
+                result = mix(result, std::to_integer<uint64_t>(bytes[i]));
+
+            return result;
+        }
+
+        // read-only view of a whole file; mapped where mmap is available, otherwise loaded into memory
+        class ReadOnlyFile
+        {
+        public:
+            ReadOnlyFile() = default;
+
+            explicit ReadOnlyFile(const std::filesystem::path& path)
+            {
+#ifdef HELPERS_HAS_MMAP
+                const int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd == -1)
+                    return;
+
+                // size of the opened file - the path may already name another file or none at all
+                struct stat st;
+                if (::fstat(fd, &st) == 0 && st.st_size > 0)
+                {
+                    const auto file_size = static_cast<size_t>(st.st_size);
+                    void* addr = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (addr != MAP_FAILED)
+                        bytes_ = {static_cast<const std::byte*>(addr), file_size};
+                }
+                ::close(fd);
+#else
+                std::ifstream in{path, std::ios::binary | std::ios::ate};
+                if (!in)
+                    return;
+
+                const std::streamoff file_size = in.tellg();
+                if (file_size < 0 || !in.seekg(0))
+                    return;
+
+                buffer_.resize(static_cast<size_t>(file_size));
+                in.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size());
+                if (in)
+                    bytes_ = buffer_;
+#endif
+            }
+
+            ReadOnlyFile(const ReadOnlyFile&) = delete;
+            ReadOnlyFile& operator=(const ReadOnlyFile&) = delete;
+
+            ReadOnlyFile(ReadOnlyFile&& other) noexcept
+                : bytes_{std::exchange(other.bytes_, {})}
+#ifndef HELPERS_HAS_MMAP
+                , buffer_{std::move(other.buffer_)}
+#endif
+            {
+            }
+
+            ReadOnlyFile& operator=(ReadOnlyFile&& other) noexcept
+            {
+                ReadOnlyFile temp{std::move(other)};
+                swap(temp);
+                return *this;
+            }
+
+            ~ReadOnlyFile()
+            {
+#ifdef HELPERS_HAS_MMAP
+                if (!bytes_.empty())
+                    ::munmap(const_cast<std::byte*>(bytes_.data()), bytes_.size());
+#endif
+            }
+
+            void swap(ReadOnlyFile& other) noexcept
+            {
+                std::swap(bytes_, other.bytes_);
+#ifndef HELPERS_HAS_MMAP
+                std::swap(buffer_, other.buffer_);
+#endif
+            }
+
+            std::span<const std::byte> bytes() const noexcept
+            {
+                return bytes_;
+            }
+
+        private:
+            std::span<const std::byte> bytes_;
+#ifndef HELPERS_HAS_MMAP
+            std::vector<std::byte> buffer_;
+#endif
+        };
+    } // namespace details
+
+    // dataset served from a cache file - the span stays valid as long as the object lives
+    template <NumericDatasetElement T>
+    class CachedDataset
+    {
+    public:
+        CachedDataset() = default;
+
+        std::span<const T> data() const noexcept
+        {
+            if (file_.bytes().empty())
+                return {};
+
+            const auto payload = file_.bytes().subspan(details::dataset_payload_offset);
+            return {reinterpret_cast<const T*>(payload.data()), payload.size() / sizeof(T)};
+        }
+
+        size_t size() const noexcept
+        {
+            return data().size();
+        }
+
+        const T* begin() const noexcept
+        {
+            return data().data();
+        }
+
+        const T* end() const noexcept
+        {
+            return begin() + size();
+        }
+
+    private:
+        friend class DatasetCache;
+
+        explicit CachedDataset(details::ReadOnlyFile file)
+            : file_{std::move(file)}
+        {
+        }
+
+        details::ReadOnlyFile file_;
+    };
+
+    // on-disk cache of fill_numeric_dataset results keyed by (generator version, element type, seed, size, low, high);
+    // by default only the header & file size are checked on load - verify_checksum reads the whole payload,
+    // which defeats lazy loading of mapped files
+    class DatasetCache
+    {
+    public:
+        explicit DatasetCache(std::filesystem::path directory, bool verify_checksum = false)
+            : directory_{std::move(directory)}
+            , verify_checksum_{verify_checksum}
+        {
+            std::filesystem::create_directories(directory_);
+        }
+
+        const std::filesystem::path& directory() const noexcept
+        {
+            return directory_;
+        }
+
+        template <NumericDatasetElement T = int>
+        [[nodiscard]] CachedDataset<T> get(size_t size, uint32_t seed = 42, std::type_identity_t<T> low = -100, std::type_identity_t<T> high = 100)
+        {
+            const auto header = make_header<T>(size, seed, low, high);
+            const auto path = file_path(header);
+
+            if (auto cached = load<T>(path, header))
+                return std::move(*cached);
+
+            store<T>(path, header);
+
+            if (auto cached = load<T>(path, header))
+                return std::move(*cached);
+
+            throw std::runtime_error(std::format("DatasetCache: cannot load '{}'", path.string()));
+        }
+
+        // removes cache files written by other generator or file format versions and temporary files
+        // left by interrupted writers; returns number of removed files
+        size_t purge_stale()
+        {
+            size_t removed = 0;
+
+            for (const auto& entry : std::filesystem::directory_iterator{directory_})
+            {
+                if (is_temp_file(entry.path()))
+                {
+                    if (std::filesystem::file_time_type::clock::now() - entry.last_write_time() > orphaned_temp_file_age)
+                        removed += std::filesystem::remove(entry.path());
+                    continue;
+                }
+
+                if (!is_cache_file(entry.path()))
+                    continue;
+
+                details::DatasetFileHeader header{};
+                std::ifstream in{entry.path(), std::ios::binary};
+                in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+                if (!in || header.magic != details::dataset_file_magic || header.format_version != details::dataset_file_format_version
+                    || header.generator_version != dataset_generator_version)
+                {
+                    in.close();
+                    removed += std::filesystem::remove(entry.path());
+                }
+            }
+
+            return removed;
+        }
+
+        // removes all cache files
+        size_t clear()
+        {
+            size_t removed = 0;
+
+            for (const auto& entry : std::filesystem::directory_iterator{directory_})
+            {
+                if (is_cache_file(entry.path()))
+                    removed += std::filesystem::remove(entry.path());
+            }
+
+            return removed;
+        }
+
+    private:
+        std::filesystem::path directory_;
+        bool verify_checksum_;
+
+        static constexpr std::string_view file_extension = ".dataset";
+        static constexpr std::string_view temp_file_extension = ".tmp";
+
+        // a writer creates its temporary file only after the data is generated - an older one is orphaned
+        static constexpr std::chrono::hours orphaned_temp_file_age{1};
+
+        template <NumericDatasetElement T>
+        static details::DatasetFileHeader make_header(size_t size, uint32_t seed, T low, T high)
+        {
+            return {
+                .element_type = details::dataset_element_type<T>,
+                .seed = seed,
+                .size = size,
+                .low = details::dataset_bound_bits(low),
+                .high = details::dataset_bound_bits(high)};
+        }
+
+        std::filesystem::path file_path(const details::DatasetFileHeader& header) const
+        {
+            return directory_
+                / std::format("g{}-t{:x}-s{}-n{}-{:016x}-{:016x}{}",
+                    header.generator_version, header.element_type, header.seed, header.size, header.low, header.high, file_extension);
+        }
+
+        static bool is_cache_file(const std::filesystem::path& path)
+        {
+            return path.extension() == file_extension;
+        }
+
+        // "<cache file>.<pid>-<random>.tmp"
+        static bool is_temp_file(const std::filesystem::path& path)
+        {
+            return path.extension() == temp_file_extension && path.stem().string().contains(file_extension);
+        }
+
+        // like mkstemp: a unique name is chosen (pid & random suffix) and the file is created only if it does not exist -
+        // two writers never share a temporary file, even when thread ids or addresses repeat between processes
+        static std::ofstream create_temp_file(const std::filesystem::path& path, std::filesystem::path& temp_path)
+        {
+            static std::atomic<uint64_t> counter{std::random_device{}()};
+
+            for (int attempt = 0; attempt < 100; ++attempt)
+            {
+                temp_path = path;
+                temp_path += std::format(".{}-{:016x}{}", details::process_id(), counter++ * 0x9E37'79B9'7F4A'7C15ULL, temp_file_extension);
+
+                std::ofstream out{temp_path, std::ios::binary | std::ios::noreplace};
+                if (out)
+                    return out;
+            }
+
+            throw std::runtime_error(std::format("DatasetCache: cannot create a temporary file for '{}'", path.string()));
+        }
+
+        template <NumericDatasetElement T>
+        std::optional<CachedDataset<T>> load(const std::filesystem::path& path, details::DatasetFileHeader expected) const
+        {
+            details::ReadOnlyFile file{path};
+            const auto bytes = file.bytes();
+
+            if (bytes.size() != details::dataset_payload_offset + expected.size * sizeof(T))
+                return std::nullopt;
+
+            details::DatasetFileHeader header{};
+            std::memcpy(&header, bytes.data(), sizeof(header));
+
+            expected.checksum = header.checksum;
+            if (header != expected)
+                return std::nullopt;
+
+            if (verify_checksum_ && details::dataset_checksum(bytes.subspan(details::dataset_payload_offset)) != header.checksum)
+                return std::nullopt;
+
+            return CachedDataset<T>{std::move(file)};
+        }
+
+        template <NumericDatasetElement T>
+        void store(const std::filesystem::path& path, details::DatasetFileHeader header) const
+        {
+            std::vector<T> data(header.size);
+            fill_numeric_dataset(std::span{data}, static_cast<uint32_t>(header.seed), bound_value<T>(header.low), bound_value<T>(header.high));
+
+            const auto payload = std::as_bytes(std::span{data});
+            header.checksum = details::dataset_checksum(payload);
+
+            std::array<std::byte, details::dataset_payload_offset> header_block{};
+            std::memcpy(header_block.data(), &header, sizeof(header));
+
+            // write to a temporary file and rename it - concurrent readers never see a partial file
+            std::filesystem::path temp_path;
+
+            {
+                std::ofstream out = create_temp_file(path, temp_path);
+                out.write(reinterpret_cast<const char*>(header_block.data()), header_block.size());
+                out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+                out.close();
+
+                if (!out)
+                {
+                    std::filesystem::remove(temp_path);
+                    throw std::runtime_error(std::format("DatasetCache: cannot write '{}'", temp_path.string()));
+                }
+            }
+
+            std::filesystem::rename(temp_path, path);
+        }
+
+        template <NumericDatasetElement T>
+        static T bound_value(uint64_t bits)
+        {
+            if constexpr (std::floating_point<T>)
+                return static_cast<T>(std::bit_cast<double>(bits));
+            else
+                return static_cast<T>(bits);
+        }
+    };
+} // namespace helpers
+
+#endif
@@ -0,0 +1,417 @@
+#ifndef DISTRIBUTIONS_HPP
+#define DISTRIBUTIONS_HPP
+
+#include "random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace helpers::random
+{
+    // generators yielding uniformly distributed 32-bit values (PCG, std::mt19937)
+    template <typename TRng>
+    concept Random32BitGenerator = std::uniform_random_bit_generator<std::remove_cvref_t<TRng>>
+        && std::remove_cvref_t<TRng>::min() == 0
+        && std::remove_cvref_t<TRng>::max() == std::numeric_limits<std::uint32_t>::max();
+
+    namespace details
+    {
+        template <typename TRng>
+        constexpr void fill_raw(TRng& rng, std::span<std::uint32_t> out)
+        {
+            if constexpr (requires { rng.fill(out); })
+                rng.fill(out);
+            else
+                std::ranges::generate(out, [&rng] { return static_cast<std::uint32_t>(rng()); });
+        }
+
+        constexpr std::uint64_t next_uint64(Random32BitGenerator auto& rng)
+        {
+            const std::uint64_t hi = static_cast<std::uint32_t>(rng());
+            return (hi << 32) | static_cast<std::uint32_t>(rng());
+        }
+
+        struct UInt128
+        {
+            std::uint64_t hi;
+            std::uint64_t lo;
+        };
+
+        // full 64 x 64 -> 128 bit product - portable and usable in constant evaluation
+        constexpr UInt128 mul_wide(std::uint64_t a, std::uint64_t b)
+        {
+            const std::uint64_t a_lo = a & 0xFFFF'FFFF, a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xFFFF'FFFF, b_hi = b >> 32;
+
+            const std::uint64_t lo_lo = a_lo * b_lo;
+            const std::uint64_t hi_lo = a_hi * b_lo;
+            const std::uint64_t lo_hi = a_lo * b_hi;
+            const std::uint64_t hi_hi = a_hi * b_hi;
+
+            const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFF'FFFF) + lo_hi;
+
+            return {.hi = hi_hi + (hi_lo >> 32) + (cross >> 32), .lo = (cross << 32) | (lo_lo & 0xFFFF'FFFF)};
+        }
+
+        // chunk for batch forms - raw values are generated with PCG::fill where available
+        inline constexpr std::size_t batch_chunk_size = 1024;
+    } // namespace details
+
+    // unbiased value from [0, range) - D. Lemire, "Fast Random Integer Generation in an Interval" (nearly divisionless)
+    constexpr std::uint32_t bounded(Random32BitGenerator auto& rng, std::uint32_t range)
+    {
+        std::uint64_t m = std::uint64_t{static_cast<std::uint32_t>(rng())} * range;
+        std::uint32_t low_bits = static_cast<std::uint32_t>(m);
+
+        if (low_bits < range)
+        {
+            const std::uint32_t threshold = (0u - range) % range;
+
+            while (low_bits < threshold)
+            {
+                m = std::uint64_t{static_cast<std::uint32_t>(rng())} * range;
+                low_bits = static_cast<std::uint32_t>(m);
+            }
+        }
+
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    constexpr std::uint64_t bounded64(Random32BitGenerator auto& rng, std::uint64_t range)
+    {
+        auto m = details::mul_wide(details::next_uint64(rng), range);
+
+        if (m.lo < range)
+        {
+            const std::uint64_t threshold = (0u - range) % range;
+
+            while (m.lo < threshold)
+                m = details::mul_wide(details::next_uint64(rng), range);
+        }
+
+        return m.hi;
+    }
+
+    namespace details
+    {
+        // raw 32-bit values needed for one canonical<T> value
+        template <std::floating_point T>
+        inline constexpr std::size_t canonical_draws = std::numeric_limits<T>::digits <= 32 ? 1 : 2;
+
+        // maps raw bits to [0, 1) - the top digits bits, or all 64 for wider types (long double)
+        template <std::floating_point T>
+        constexpr T canonical_from_bits(std::uint64_t bits)
+        {
+            if constexpr (canonical_draws<T> == 1)
+                return static_cast<T>(static_cast<std::uint32_t>(bits) >> (32 - std::numeric_limits<T>::digits))
+                    * (T{1} / static_cast<T>(std::uint64_t{1} << std::numeric_limits<T>::digits));
+            else if constexpr (std::numeric_limits<T>::digits < 64)
+                return static_cast<T>(bits >> (64 - std::numeric_limits<T>::digits))
+                    * (T{1} / static_cast<T>(std::uint64_t{1} << std::numeric_limits<T>::digits));
+            else // 2^64 does not fit in uint64_t - all 64 bits are exact in T
+                return static_cast<T>(bits) * (T{1} / (T{4'294'967'296.0} * T{4'294'967'296.0}));
+        }
+    } // namespace details
+
+    // value from [0, 1) built from raw bits: 24 random bits for float, 53 for double, 64 for wider types (long double)
+    template <std::floating_point T>
+    constexpr T canonical(Random32BitGenerator auto& rng)
+    {
+        if constexpr (details::canonical_draws<T> == 1)
+            return details::canonical_from_bits<T>(static_cast<std::uint32_t>(rng()));
+        else
+            return details::canonical_from_bits<T>(details::next_uint64(rng));
+    }
+
+    // uniform integers from closed range [a, b] - unbiased and without division in the common case
+    template <std::integral T>
+    struct UniformInt
+    {
+        using result_type = T;
+        using unsigned_type = std::make_unsigned_t<T>;
+
+        T a;
+        T b;
+
+        constexpr UniformInt(T a, T b) : a{a}, b{b}
+        {
+        }
+
+        constexpr T operator()(Random32BitGenerator auto& rng) const
+        {
+            const unsigned_type width = static_cast<unsigned_type>(b) - static_cast<unsigned_type>(a);
+
+            if constexpr (sizeof(T) <= sizeof(std::uint32_t))
+            {
+                const auto offset = width == std::numeric_limits<std::uint32_t>::max()
+                    ? static_cast<std::uint32_t>(rng())
+                    : bounded(rng, static_cast<std::uint32_t>(width) + 1);
+                return static_cast<T>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(offset));
+            }
+            else
+            {
+                const auto offset = width == std::numeric_limits<std::uint64_t>::max() ? details::next_uint64(rng) : bounded64(rng, width + 1);
+                return static_cast<T>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(offset));
+            }
+        }
+
+        constexpr void fill(Random32BitGenerator auto& rng, std::span<T> out) const
+        {
+            if constexpr (sizeof(T) <= sizeof(std::uint32_t))
+            {
+                const unsigned_type width = static_cast<unsigned_type>(b) - static_cast<unsigned_type>(a);
+                if (width == std::numeric_limits<std::uint32_t>::max())
+                {
+                    for (auto& item : out)
+                        item = (*this)(rng);
+                    return;
+                }
+
+                const std::uint32_t range = static_cast<std::uint32_t>(width) + 1;
+                const std::uint32_t threshold = (0u - range) % range; // one division per batch
+                std::array<std::uint32_t, details::batch_chunk_size> raw{};
+
+                for (std::size_t offset = 0; offset < out.size(); offset += raw.size())
+                {
+                    const auto chunk = out.subspan(offset, std::min(raw.size(), out.size() - offset));
+                    details::fill_raw(rng, std::span{raw}.first(chunk.size()));
+
+                    for (std::size_t i = 0; i < chunk.size(); ++i)
+                    {
+                        std::uint64_t m = std::uint64_t{raw[i]} * range;
+                        while (static_cast<std::uint32_t>(m) < threshold) // rare rejection
+                            m = std::uint64_t{static_cast<std::uint32_t>(rng())} * range;
+
+                        chunk[i] = static_cast<T>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(m >> 32));
+                    }
+                }
+            }
+            else
+            {
+                for (auto& item : out)
+                    item = (*this)(rng);
+            }
+        }
+    };
+
+    // uniform floating-point values from [a, b)
+    template <std::floating_point T>
+    struct UniformReal
+    {
+        using result_type = T;
+
+        T a = 0;
+        T b = 1;
+
+        constexpr T operator()(Random32BitGenerator auto& rng) const
+        {
+            return a + (b - a) * canonical<T>(rng);
+        }
+
+        constexpr void fill(Random32BitGenerator auto& rng, std::span<T> out) const
+        {
+            constexpr std::size_t draws = details::canonical_draws<T>;
+            std::array<std::uint32_t, details::batch_chunk_size> raw{};
+
+            for (std::size_t offset = 0; offset < out.size(); offset += raw.size() / draws)
+            {
+                const auto chunk = out.subspan(offset, std::min(raw.size() / draws, out.size() - offset));
+                details::fill_raw(rng, std::span{raw}.first(chunk.size() * draws));
+
+                for (std::size_t i = 0; i < chunk.size(); ++i)
+                {
+                    if constexpr (draws == 1)
+                        chunk[i] = a + (b - a) * details::canonical_from_bits<T>(raw[i]);
+                    else
+                        chunk[i] = a + (b - a) * details::canonical_from_bits<T>((std::uint64_t{raw[2 * i]} << 32) | raw[2 * i + 1]);
+                }
+            }
+        }
+    };
+
+    // normal distribution - Marsaglia polar method, values are produced in pairs
+    template <std::floating_point T>
+    struct Normal
+    {
+        using result_type = T;
+
+        T mean;
+        T stddev;
+
+        explicit Normal(T mean = 0, T stddev = 1) : mean{mean}, stddev{stddev}
+        {
+        }
+
+        T operator()(Random32BitGenerator auto& rng)
+        {
+            if (has_spare_)
+            {
+                has_spare_ = false;
+                return spare_;
+            }
+
+            const UniformReal<T> uniform{-1, 1};
+            const auto [z0, z1] = polar_pair([&] { return uniform(rng); });
+            spare_ = z1;
+            has_spare_ = true;
+
+            return z0;
+        }
+
+        void fill(Random32BitGenerator auto& rng, std::span<T> out)
+        {
+            const UniformReal<T> uniform{-1, 1};
+            std::array<T, details::batch_chunk_size> uniforms{};
+            std::size_t pos = uniforms.size();
+
+            auto next_uniform = [&] {
+                if (pos == uniforms.size())
+                {
+                    uniform.fill(rng, uniforms);
+                    pos = 0;
+                }
+                return uniforms[pos++];
+            };
+
+            for (std::size_t i = 0; i < out.size(); i += 2)
+            {
+                const auto [z0, z1] = polar_pair(next_uniform);
+                out[i] = z0;
+                if (i + 1 < out.size())
+                    out[i + 1] = z1;
+            }
+        }
+
+    private:
+        T spare_ = 0;
+        bool has_spare_ = false;
+
+        std::pair<T, T> polar_pair(std::invocable auto next_uniform) const
+        {
+            T u, v, s;
+            do
+            {
+                u = next_uniform();
+                v = next_uniform();
+                s = u * u + v * v;
+            } while (s >= 1 || s == 0);
+
+            const T factor = stddev * std::sqrt(T{-2} * std::log(s) / s);
+
+            return {mean + u * factor, mean + v * factor};
+        }
+    };
+
+    // Zipf distribution over ranks [1, n] with P(k) ~ 1 / k^s, s > 0 - O(1) per value independent of n
+    // W. Hörmann, G. Derflinger, "Rejection-inversion to generate variates from monotone discrete distributions"
+    class Zipf
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        Zipf(std::uint64_t n, double s)
+            : n_{n}
+            , s_{s}
+            , h_integral_x1_{h_integral(1.5) - 1.0}
+            , h_integral_n_{h_integral(static_cast<double>(n) + 0.5)}
+            , threshold_{2.0 - h_integral_inverse(h_integral(2.5) - h(2.0))}
+        {
+        }
+
+        std::uint64_t n() const
+        {
+            return n_;
+        }
+
+        double s() const
+        {
+            return s_;
+        }
+
+        std::uint64_t operator()(Random32BitGenerator auto& rng) const
+        {
+            while (true)
+            {
+                if (auto k = try_sample(canonical<double>(rng)); k != 0)
+                    return k;
+            }
+        }
+
+        void fill(Random32BitGenerator auto& rng, std::span<std::uint64_t> out) const
+        {
+            std::array<double, details::batch_chunk_size> uniforms{};
+            const UniformReal<double> uniform{};
+
+            for (std::size_t offset = 0; offset < out.size(); offset += uniforms.size())
+            {
+                const auto chunk = out.subspan(offset, std::min(uniforms.size(), out.size() - offset));
+                uniform.fill(rng, std::span{uniforms}.first(chunk.size()));
+
+                for (std::size_t i = 0; i < chunk.size(); ++i)
+                {
+                    const auto k = try_sample(uniforms[i]);
+                    chunk[i] = k != 0 ? k : (*this)(rng);
+                }
+            }
+        }
+
+    private:
+        std::uint64_t n_;
+        double s_;
+        double h_integral_x1_;
+        double h_integral_n_;
+        double threshold_;
+
+        // returns 0 when the candidate is rejected
+        std::uint64_t try_sample(double uniform) const
+        {
+            const double u = h_integral_n_ + uniform * (h_integral_x1_ - h_integral_n_);
+            const double x = h_integral_inverse(u);
+
+            const auto k = static_cast<std::uint64_t>(std::clamp(x + 0.5, 1.0, static_cast<double>(n_)));
+
+            if (static_cast<double>(k) - x <= threshold_ || u >= h_integral(static_cast<double>(k) + 0.5) - h(static_cast<double>(k)))
+                return k;
+
+            return 0;
+        }
+
+        double h(double x) const
+        {
+            return std::exp(-s_ * std::log(x));
+        }
+
+        double h_integral(double x) const
+        {
+            const double log_x = std::log(x);
+            return helper2((1.0 - s_) * log_x) * log_x;
+        }
+
+        double h_integral_inverse(double x) const
+        {
+            const double t = std::max(x * (1.0 - s_), -1.0);
+            return std::exp(helper1(t) * x);
+        }
+
+        // log1p(x) / x with a series near 0
+        static double helper1(double x)
+        {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+        }
+
+        // expm1(x) / x with a series near 0
+        static double helper2(double x)
+        {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+        }
+    };
+} // namespace helpers::random
+
+#endif
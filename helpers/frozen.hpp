@@ -0,0 +1,423 @@
+#ifndef FROZEN_HPP
+#define FROZEN_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// immutable containers for key sets known at compile time, built by consteval factories - lookups
+// do not allocate and do not branch on the data except for the final key comparison
+// (keys and values must be default constructible)
+namespace helpers::frozen
+{
+    namespace details
+    {
+        // finalizer of MurmurHash3 - every input bit affects every output bit
+        constexpr std::uint64_t mix(std::uint64_t x)
+        {
+            x ^= x >> 33;
+            x *= 0xFF51'AFD7'ED55'8CCDULL;
+            x ^= x >> 33;
+            x *= 0xC4CE'B9FE'1A85'EC53ULL;
+            x ^= x >> 33;
+            return x;
+        }
+    } // namespace details
+
+    // seeded hash usable in constant evaluation - integers, enums and strings out of the box
+    template <typename Key>
+    struct Hash;
+
+    template <typename Key>
+        requires std::integral<Key> || std::is_enum_v<Key>
+    struct Hash<Key>
+    {
+        constexpr std::uint64_t operator()(Key key, std::uint64_t seed) const
+        {
+            return details::mix(static_cast<std::uint64_t>(key) + seed * 0x9E37'79B9'7F4A'7C15ULL);
+        }
+    };
+
+    template <>
+    struct Hash<std::string_view>
+    {
+        // FNV-1a started from the seed
+        constexpr std::uint64_t operator()(std::string_view key, std::uint64_t seed) const
+        {
+            std::uint64_t hash = 0xCBF2'9CE4'8422'2325ULL ^ details::mix(seed);
+            for (char c : key)
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100'0000'01B3ULL;
+            return details::mix(hash);
+        }
+    };
+
+    namespace details
+    {
+        template <typename Key, std::size_t N>
+        consteval void sort_and_check_unique(std::array<Key, N>& keys, std::array<std::size_t, N>& order)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                order[i] = i;
+
+            std::ranges::sort(order, [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+            std::array<Key, N> sorted{};
+            for (std::size_t i = 0; i < N; ++i)
+                sorted[i] = keys[order[i]];
+            keys = sorted;
+
+            if (std::ranges::adjacent_find(keys) != keys.end())
+                throw std::invalid_argument("duplicated key");
+        }
+
+        // keys compared during the binary search - strings by their first 8 chars packed big-endian,
+        // which orders them like the strings, so most steps are integer comparisons
+        template <typename Key>
+        constexpr auto search_key(const Key& key)
+        {
+            if constexpr (std::same_as<Key, std::string_view>)
+            {
+                std::uint64_t prefix = 0;
+                for (std::size_t i = 0; i < sizeof(prefix); ++i)
+                    prefix = (prefix << 8) | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0);
+                return prefix;
+            }
+            else
+                return key;
+        }
+
+        template <typename Key>
+        using SearchKey = decltype(search_key(std::declval<const Key&>()));
+
+        // index of the first key not less than key - the loop count depends only on N
+        template <typename Key, std::size_t N>
+        constexpr std::size_t lower_bound(const std::array<Key, N>& keys, const Key& key)
+        {
+            if constexpr (N == 0)
+                return 0;
+            else
+            {
+                std::size_t first = 0;
+                for (std::size_t length = N; length > 1; length -= length / 2)
+                    first = keys[first + length / 2] < key ? first + length / 2 : first;
+
+                return keys[first] < key ? first + 1 : first;
+            }
+        }
+
+        // hash and displace: a key goes to bucket hash(key, seed) % buckets, and every bucket gets its own
+        // seed placing all its keys in free slots; buckets are placed from the largest one
+        template <typename Key, std::size_t N, typename Hasher>
+        struct PerfectHashIndex
+        {
+            static constexpr std::size_t slot_count = std::bit_ceil(N + N / 4 + 1);
+            static constexpr std::size_t bucket_count = std::bit_ceil(N / 2 + 1);
+
+            std::uint64_t seed = 0;
+            std::array<std::uint32_t, bucket_count> bucket_seeds{};
+
+            constexpr std::size_t bucket(const Key& key) const
+            {
+                return Hasher{}(key, seed) & (bucket_count - 1);
+            }
+
+            // bucket seeds are below 2^32 and the global seed is combined into their upper bits,
+            // so the second hash never repeats the first one
+            constexpr std::size_t slot(const Key& key) const
+            {
+                return Hasher{}(key, (std::uint64_t{bucket_seeds[bucket(key)]} << 32) ^ seed) & (slot_count - 1);
+            }
+
+            // slots[i] - slot of keys[i]
+            consteval std::array<std::size_t, N> build(const std::array<Key, N>& keys)
+            {
+                for (seed = 1;; ++seed)
+                {
+                    if (std::array<std::size_t, N> slots{}; try_build(keys, slots))
+                        return slots;
+
+                    if (seed > 1'000)
+                        throw std::logic_error("no perfect hash found - are keys unique and the hash good enough?");
+                }
+            }
+
+        private:
+            consteval bool try_build(const std::array<Key, N>& keys, std::array<std::size_t, N>& slots)
+            {
+                std::array<std::size_t, N> buckets{};
+                std::array<std::size_t, bucket_count> bucket_sizes{};
+                for (std::size_t i = 0; i < N; ++i)
+                    ++bucket_sizes[buckets[i] = bucket(keys[i])];
+
+                std::array<std::size_t, bucket_count> bucket_order{};
+                for (std::size_t b = 0; b < bucket_count; ++b)
+                    bucket_order[b] = b;
+                std::ranges::sort(bucket_order, [&](std::size_t a, std::size_t b) {
+                    return bucket_sizes[a] != bucket_sizes[b] ? bucket_sizes[a] > bucket_sizes[b] : a < b;
+                });
+
+                std::array<bool, slot_count> taken{};
+                for (std::size_t b : bucket_order)
+                {
+                    if (bucket_sizes[b] == 0)
+                        break;
+
+                    bool placed = false;
+                    for (std::uint32_t bucket_seed = 1; bucket_seed < (1u << 16) && !placed; ++bucket_seed)
+                    {
+                        bucket_seeds[b] = bucket_seed;
+                        std::array<bool, slot_count> candidate = taken;
+
+                        placed = true;
+                        for (std::size_t i = 0; i < N && placed; ++i)
+                        {
+                            if (buckets[i] != b)
+                                continue;
+
+                            slots[i] = slot(keys[i]);
+                            placed = !candidate[slots[i]];
+                            candidate[slots[i]] = true;
+                        }
+
+                        if (placed)
+                            taken = candidate;
+                    }
+
+                    if (!placed)
+                        return false;
+                }
+
+                return true;
+            }
+        };
+    } // namespace details
+
+    // sorted keys with a fixed-depth binary search over search keys; values are kept apart,
+    // so the search touches keys only
+    template <typename Key, typename Value, std::size_t N>
+    class FlatMap
+    {
+        std::array<details::SearchKey<Key>, N> search_keys_{};
+        std::array<Key, N> keys_{};
+        std::array<Value, N> values_{};
+
+    public:
+        consteval FlatMap(const std::array<std::pair<Key, Value>, N>& entries)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                keys_[i] = entries[i].first;
+
+            std::array<std::size_t, N> order{};
+            details::sort_and_check_unique(keys_, order);
+
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                search_keys_[i] = details::search_key(keys_[i]);
+                values_[i] = entries[order[i]].second;
+            }
+        }
+
+        static constexpr std::size_t size()
+        {
+            return N;
+        }
+
+        constexpr const Value* find(const Key& key) const
+        {
+            const auto probe = details::search_key(key);
+
+            // more than one iteration only for strings sharing the first 8 chars
+            for (std::size_t index = details::lower_bound(search_keys_, probe); index < N && search_keys_[index] == probe; ++index)
+            {
+                if (keys_[index] == key)
+                    return &values_[index];
+            }
+
+            return nullptr;
+        }
+
+        constexpr bool contains(const Key& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        constexpr const Value& at(const Key& key) const
+        {
+            if (const Value* value = find(key))
+                return *value;
+
+            throw std::out_of_range("key not found");
+        }
+
+        constexpr const std::array<Key, N>& keys() const
+        {
+            return keys_;
+        }
+
+        constexpr const std::array<Value, N>& values() const
+        {
+            return values_;
+        }
+    };
+
+    template <typename Key, std::size_t N>
+    class FlatSet
+    {
+        FlatMap<Key, bool, N> map_;
+
+        static consteval std::array<std::pair<Key, bool>, N> entries(const std::array<Key, N>& keys)
+        {
+            std::array<std::pair<Key, bool>, N> entries{};
+            for (std::size_t i = 0; i < N; ++i)
+                entries[i] = {keys[i], true};
+            return entries;
+        }
+
+    public:
+        consteval FlatSet(const std::array<Key, N>& keys)
+            : map_{entries(keys)}
+        {
+        }
+
+        static constexpr std::size_t size()
+        {
+            return N;
+        }
+
+        constexpr bool contains(const Key& key) const
+        {
+            return map_.contains(key);
+        }
+
+        constexpr const std::array<Key, N>& keys() const
+        {
+            return map_.keys();
+        }
+    };
+
+    // two hashes and one key comparison per lookup - empty slots hold a copy of the first key,
+    // which lives in another slot, so they never match
+    template <typename Key, typename Value, std::size_t N, typename Hasher = Hash<Key>>
+        requires (N > 0)
+    class PerfectHashMap
+    {
+        using Index = details::PerfectHashIndex<Key, N, Hasher>;
+
+        Index index_{};
+        std::array<Key, Index::slot_count> keys_{};
+        std::array<Value, Index::slot_count> values_{};
+
+    public:
+        consteval PerfectHashMap(const std::array<std::pair<Key, Value>, N>& entries)
+        {
+            std::array<Key, N> keys{};
+            for (std::size_t i = 0; i < N; ++i)
+                keys[i] = entries[i].first;
+
+            std::array<Key, N> sorted_keys = keys;
+            std::array<std::size_t, N> order{};
+            details::sort_and_check_unique(sorted_keys, order);
+
+            const auto slots = index_.build(keys);
+
+            keys_.fill(keys[0]);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                keys_[slots[i]] = keys[i];
+                values_[slots[i]] = entries[i].second;
+            }
+        }
+
+        static constexpr std::size_t size()
+        {
+            return N;
+        }
+
+        constexpr const Value* find(const Key& key) const
+        {
+            const std::size_t slot = index_.slot(key);
+            return keys_[slot] == key ? &values_[slot] : nullptr;
+        }
+
+        constexpr bool contains(const Key& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        constexpr const Value& at(const Key& key) const
+        {
+            if (const Value* value = find(key))
+                return *value;
+
+            throw std::out_of_range("key not found");
+        }
+    };
+
+    template <typename Key, std::size_t N, typename Hasher = Hash<Key>>
+        requires (N > 0)
+    class PerfectHashSet
+    {
+        using Index = details::PerfectHashIndex<Key, N, Hasher>;
+
+        Index index_{};
+        std::array<Key, Index::slot_count> keys_{};
+
+    public:
+        consteval PerfectHashSet(const std::array<Key, N>& keys)
+        {
+            std::array<Key, N> sorted_keys = keys;
+            std::array<std::size_t, N> order{};
+            details::sort_and_check_unique(sorted_keys, order);
+
+            const auto slots = index_.build(keys);
+
+            keys_.fill(keys[0]);
+            for (std::size_t i = 0; i < N; ++i)
+                keys_[slots[i]] = keys[i];
+        }
+
+        static constexpr std::size_t size()
+        {
+            return N;
+        }
+
+        constexpr bool contains(const Key& key) const
+        {
+            return keys_[index_.slot(key)] == key;
+        }
+    };
+
+    // make_flat_map<std::string_view, double>({{"pl", 0.23}, {"de", 0.19}})
+    template <typename Key, typename Value, std::size_t N>
+    consteval auto make_flat_map(const std::pair<Key, Value> (&entries)[N])
+    {
+        return FlatMap<Key, Value, N>{std::to_array(entries)};
+    }
+
+    template <typename Key, std::size_t N>
+    consteval auto make_flat_set(const Key (&keys)[N])
+    {
+        return FlatSet<Key, N>{std::to_array(keys)};
+    }
+
+    template <typename Key, typename Value, std::size_t N>
+    consteval auto make_perfect_hash_map(const std::pair<Key, Value> (&entries)[N])
+    {
+        return PerfectHashMap<Key, Value, N>{std::to_array(entries)};
+    }
+
+    template <typename Key, std::size_t N>
+    consteval auto make_perfect_hash_set(const Key (&keys)[N])
+    {
+        return PerfectHashSet<Key, N>{std::to_array(keys)};
+    }
+} // namespace helpers::frozen
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef FUNCTION_HPP
+#define FUNCTION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace helpers
+{
+    // inline buffer of inplace_function & unique_function - with two pointers an object takes one cache line
+    inline constexpr size_t default_function_capacity = 48;
+
+    namespace details
+    {
+        // std::invoke_r is C++23 - the header is also used by C++20 modules
+        template <typename TResult, typename F, typename... TArgs>
+        TResult invoke_r(F&& f, TArgs&&... args)
+        {
+            if constexpr (std::is_void_v<TResult>)
+                std::invoke(std::forward<F>(f), std::forward<TArgs>(args)...);
+            else
+                return std::invoke(std::forward<F>(f), std::forward<TArgs>(args)...);
+        }
+
+        enum class FunctionOperation
+        {
+            move, // move constructs destination from source and destroys source
+            copy,
+            destroy
+        };
+
+        // callable stored in an inline buffer - never allocates; callables that do not fit are rejected at compile time
+        template <typename Signature, size_t Capacity, bool Copyable>
+        class InplaceFunction;
+
+        template <typename TResult, typename... TArgs, size_t Capacity, bool Copyable>
+        class InplaceFunction<TResult(TArgs...), Capacity, Copyable>
+        {
+            template <typename, size_t, bool>
+            friend class InplaceFunction;
+
+            using Invoker = TResult (*)(void* storage, TArgs&&... args);
+            using Manager = void (*)(FunctionOperation operation, void* destination, void* source);
+
+            alignas(std::max_align_t) std::byte storage_[Capacity];
+            Invoker invoke_ = &invoke_empty;
+            Manager manage_ = nullptr;
+
+            [[noreturn]] static TResult invoke_empty(void*, TArgs&&...)
+            {
+                throw std::bad_function_call{};
+            }
+
+            template <typename F>
+            static TResult invoke_target(void* storage, TArgs&&... args)
+            {
+                return details::invoke_r<TResult>(*static_cast<F*>(storage), std::forward<TArgs>(args)...);
+            }
+
+            template <typename F>
+            static void manage_target(FunctionOperation operation, void* destination, void* source)
+            {
+                switch (operation)
+                {
+                case FunctionOperation::move:
+                    ::new (destination) F(std::move(*static_cast<F*>(source)));
+                    static_cast<F*>(source)->~F();
+                    break;
+                case FunctionOperation::copy:
+                    if constexpr (Copyable)
+                        ::new (destination) F(*static_cast<const F*>(source));
+                    break;
+                case FunctionOperation::destroy:
+                    static_cast<F*>(source)->~F();
+                    break;
+                }
+            }
+
+            template <typename F>
+            static bool is_null(const F& f)
+            {
+                if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>)
+                    return f == nullptr;
+                else
+                    return false;
+            }
+
+        public:
+            InplaceFunction() noexcept = default;
+
+            InplaceFunction(std::nullptr_t) noexcept
+            {
+            }
+
+            template <typename F, typename TCallable = std::decay_t<F>>
+                requires(!std::same_as<TCallable, InplaceFunction>) && std::is_invocable_r_v<TResult, TCallable&, TArgs...>
+            InplaceFunction(F&& f)
+            {
+                static_assert(sizeof(TCallable) <= Capacity, "callable does not fit in the inline buffer - increase Capacity");
+                static_assert(alignof(TCallable) <= alignof(std::max_align_t), "callable is over-aligned");
+                static_assert(std::is_nothrow_move_constructible_v<TCallable>, "callable must be nothrow move constructible");
+                static_assert(!Copyable || std::is_copy_constructible_v<TCallable>, "callable must be copyable - use unique_function");
+
+                if (is_null(f))
+                    return;
+
+                ::new (static_cast<void*>(storage_)) TCallable(std::forward<F>(f));
+                invoke_ = &invoke_target<TCallable>;
+                manage_ = &manage_target<TCallable>;
+            }
+
+            // from a wrapper with a smaller buffer
+            template <size_t OtherCapacity>
+                requires(OtherCapacity < Capacity)
+            InplaceFunction(InplaceFunction<TResult(TArgs...), OtherCapacity, Copyable>&& other) noexcept
+                : invoke_{std::exchange(other.invoke_, &invoke_empty)}
+                , manage_{std::exchange(other.manage_, nullptr)}
+            {
+                if (manage_)
+                    manage_(FunctionOperation::move, storage_, other.storage_);
+            }
+
+            InplaceFunction(const InplaceFunction& other)
+                requires Copyable
+                : invoke_{other.invoke_}
+                , manage_{other.manage_}
+            {
+                if (manage_)
+                    manage_(FunctionOperation::copy, storage_, const_cast<std::byte*>(other.storage_));
+            }
+
+            InplaceFunction(InplaceFunction&& other) noexcept
+                : invoke_{std::exchange(other.invoke_, &invoke_empty)}
+                , manage_{std::exchange(other.manage_, nullptr)}
+            {
+                if (manage_)
+                    manage_(FunctionOperation::move, storage_, other.storage_);
+            }
+
+            InplaceFunction& operator=(const InplaceFunction& other)
+                requires Copyable
+            {
+                if (this != &other)
+                {
+                    InplaceFunction temp{other};
+                    *this = std::move(temp);
+                }
+
+                return *this;
+            }
+
+            InplaceFunction& operator=(InplaceFunction&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    invoke_ = std::exchange(other.invoke_, &invoke_empty);
+                    manage_ = std::exchange(other.manage_, nullptr);
+                    if (manage_)
+                        manage_(FunctionOperation::move, storage_, other.storage_);
+                }
+
+                return *this;
+            }
+
+            InplaceFunction& operator=(std::nullptr_t) noexcept
+            {
+                reset();
+                return *this;
+            }
+
+            ~InplaceFunction()
+            {
+                reset();
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return manage_ != nullptr;
+            }
+
+            // like std::function - const call operator, the target is invoked as non-const; throws std::bad_function_call when empty
+            TResult operator()(TArgs... args) const
+            {
+                return invoke_(const_cast<std::byte*>(storage_), std::forward<TArgs>(args)...);
+            }
+
+            friend void swap(InplaceFunction& a, InplaceFunction& b) noexcept
+            {
+                std::swap(a, b);
+            }
+
+        private:
+            void reset() noexcept
+            {
+                if (manage_)
+                    manage_(FunctionOperation::destroy, nullptr, storage_);
+
+                invoke_ = &invoke_empty;
+                manage_ = nullptr;
+            }
+        };
+    } // namespace details
+
+    // copyable replacement of std::function that never allocates
+    template <typename Signature, size_t Capacity = default_function_capacity>
+    using inplace_function = details::InplaceFunction<Signature, Capacity, true>;
+
+    // move-only variant - accepts callables owning move-only state (e.g. std::unique_ptr)
+    template <typename Signature, size_t Capacity = default_function_capacity>
+    using unique_function = details::InplaceFunction<Signature, Capacity, false>;
+
+    // non-owning reference to a callable - two pointers, passed by value; the callable must outlive it
+    template <typename Signature>
+    class function_ref;
+
+    template <typename TResult, typename... TArgs>
+    class function_ref<TResult(TArgs...)>
+    {
+        union Target
+        {
+            void* object;
+            void (*function)();
+        };
+
+        Target target_;
+        TResult (*invoke_)(Target target, TArgs&&... args);
+
+    public:
+        template <typename F>
+            requires std::is_function_v<F> && std::is_invocable_r_v<TResult, F&, TArgs...>
+        function_ref(F* function) noexcept
+            : target_{.function = reinterpret_cast<void (*)()>(function)}
+            , invoke_{[](Target target, TArgs&&... args) -> TResult {
+                return details::invoke_r<TResult>(reinterpret_cast<F*>(target.function), std::forward<TArgs>(args)...);
+            }}
+        {
+        }
+
+        template <typename F, typename TCallable = std::remove_reference_t<F>>
+            requires(!std::same_as<std::remove_cv_t<TCallable>, function_ref>) && (!std::is_pointer_v<TCallable>)
+                 && std::is_invocable_r_v<TResult, TCallable&, TArgs...>
+        function_ref(F&& f) noexcept
+        {
+            if constexpr (std::is_function_v<TCallable>)
+            {
+                target_.function = reinterpret_cast<void (*)()>(&f);
+                invoke_ = [](Target target, TArgs&&... args) -> TResult {
+                    return details::invoke_r<TResult>(reinterpret_cast<TCallable*>(target.function), std::forward<TArgs>(args)...);
+                };
+            }
+            else
+            {
+                target_.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+                invoke_ = [](Target target, TArgs&&... args) -> TResult {
+                    return details::invoke_r<TResult>(*static_cast<TCallable*>(target.object), std::forward<TArgs>(args)...);
+                };
+            }
+        }
+
+        TResult operator()(TArgs... args) const
+        {
+            return invoke_(target_, std::forward<TArgs>(args)...);
+        }
+    };
+} // namespace helpers
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef HELPERS_HPP
 #define HELPERS_HPP
 
+#include "distributions.hpp"
 #include "random.hpp"
 
 #include <iostream>
@@ -8,40 +9,151 @@
 #include <ranges>
 #include <algorithm>
 #include <utility>
+#include <array>
+#include <concepts>
+#include <cerrno>
+#include <charconv>
 #include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace helpers
 {
     template <typename T>
     concept PrintableRange = std::ranges::range<T> && requires(std::ranges::range_value_t<T>&& item) { std::cout << item; };
 
-    void print(PrintableRange auto&& rng, std::string_view prefix = "rng")
+    struct PrintOptions
     {
-        std::cout << prefix << " = [ ";
-        for (const auto& item : rng)
+        int fd = 1;                                                 // target file descriptor (1 - stdout)
+        size_t max_items = std::numeric_limits<size_t>::max();      // remaining items are replaced with "..."
+        size_t flush_threshold = 64 * 1024;                         // buffered bytes that trigger a write
+    };
+
+    namespace details
+    {
+        inline void write_all(int fd, std::string_view data)
         {
-            if constexpr (std::convertible_to<decltype(item), std::string_view>)
+            if (fd == 1) // keep order with output already buffered in std::cout and stdout
+            {
+                std::cout.flush();
+                std::fflush(stdout);
+            }
+
+            while (!data.empty())
             {
-                std::cout << '"' << item << '"' << " ";
+#ifdef _WIN32
+                const auto written = ::_write(fd, data.data(), static_cast<unsigned>(data.size()));
+#else
+                const auto written = ::write(fd, data.data(), data.size());
+#endif
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                    return;
+
+                data.remove_prefix(static_cast<size_t>(written));
             }
+        }
+
+        // formats short text (numbers) on the stack - avoids growing buffer char by char
+        template <typename... TArgs>
+        void append_formatted(std::string& buffer, std::format_string<const TArgs&...> fmt, const TArgs&... args)
+        {
+            std::array<char, 64> text;
+
+            if (const auto result = std::format_to_n(text.data(), text.size(), fmt, args...); std::cmp_less_equal(result.size, text.size()))
+                buffer.append(text.data(), result.out);
             else
+                std::format_to(std::back_inserter(buffer), fmt, args...);
+        }
+
+        // formats item exactly as std::ostream with default flags would do
+        template <typename T>
+        void format_item(std::string& buffer, const T& item)
+        {
+            if constexpr (std::convertible_to<const T&, std::string_view>)
             {
-                std::cout << item << " ";
+                buffer.push_back('"');
+                buffer.append(std::string_view{item});
+                buffer.append("\" ");
+            }
+            else if constexpr (std::same_as<T, bool>)
+                append_formatted(buffer, "{:d} ", item);
+            else if constexpr (std::same_as<T, char>)
+                append_formatted(buffer, "{} ", item);
+            else if constexpr (std::integral<T> && !std::same_as<T, signed char> && !std::same_as<T, unsigned char>)
+            {
+                std::array<char, std::numeric_limits<T>::digits10 + 3> text;
+                auto [end, _] = std::to_chars(text.data(), text.data() + text.size(), item);
+                *end++ = ' ';
+                buffer.append(text.data(), end);
+            }
+            else if constexpr (std::floating_point<T>)
+                append_formatted(buffer, "{:.6g} ", item);
+            else
+            {
+                thread_local std::ostringstream stream;
+                stream.str({});
+                stream << item;
+                buffer.append(stream.view());
+                buffer.push_back(' ');
+            }
+        }
+    } // namespace details
+
+    // output is formatted into a reusable thread-local buffer and written in large chunks
+    void print(PrintableRange auto&& rng, std::string_view prefix = "rng", const PrintOptions& options = {})
+    {
+        thread_local std::string buffer;
+        buffer.clear();
+
+        std::format_to(std::back_inserter(buffer), "{} = [ ", prefix);
+
+        size_t count = 0;
+        for (const auto& item : rng)
+        {
+            if (count++ == options.max_items)
+            {
+                buffer.append("... ");
+                break;
+            }
+
+            details::format_item(buffer, item);
+
+            if (buffer.size() >= options.flush_threshold)
+            {
+                details::write_all(options.fd, buffer);
+                buffer.clear();
             }
         }
-        std::cout << "]\n";
+
+        buffer.append("]\n");
+        details::write_all(options.fd, buffer);
+        buffer.clear();
     }
 
     template <size_t Size>
     [[nodiscard]] constexpr auto create_numeric_dataset(uint32_t seed = 42, int low = -100, int high = 100)
     {
-        std::vector<int> data(Size);
-        data.reserve(Size);
+        std::array<int, Size> data{};
 
-        auto uniform_distr = [low, high](auto&& rnd_gen) {
-            uint32_t width = high - low;
-            return (rnd_gen() % width) + low;
-        };
+        const random::UniformInt<int> uniform_distr{low, high - 1};
 
         if (std::is_constant_evaluated())
         {
@@ -56,10 +168,107 @@ namespace helpers
             std::ranges::generate(data, [&] { return uniform_distr(mt_rnd); });
         }
 
-        std::array<int, Size> result_data{};
-        std::ranges::copy(data, result_data.begin());
+        return data;
+    }
+
+    // floating point elements take at most 64 random bits - long double (64-bit mantissa on x86-64) is excluded
+    template <typename T>
+    concept NumericDatasetElement = (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> || std::same_as<T, double>;
+
+    namespace details
+    {
+        // every element consumes a fixed number of 32-bit draws, so a chunk can jump straight to its position in the stream
+        template <NumericDatasetElement T>
+        constexpr size_t draws_per_element = sizeof(T) > sizeof(uint32_t) ? 2 : 1;
+
+        template <NumericDatasetElement T>
+        constexpr T map_to_range(uint64_t bits, T low, T high)
+        {
+            if constexpr (std::floating_point<T>)
+            {
+                constexpr int digits = std::numeric_limits<T>::digits;
+                constexpr int bits_count = 32 * draws_per_element<T>;
+                const T unit = static_cast<T>(bits >> (bits_count - digits)) * (T{1} / static_cast<T>(uint64_t{1} << digits)); // [0, 1)
+
+                return low + (high - low) * unit;
+            }
+            else
+            {
+                // multiply-shift without rejection keeps the number of draws fixed; bias is below width / 2^(32 * draws)
+                using U = std::make_unsigned_t<T>;
+                const U width = static_cast<U>(high) - static_cast<U>(low);
+
+                uint64_t offset;
+                if constexpr (draws_per_element<T> == 1)
+                    offset = (bits * width) >> 32;
+                else
+                    offset = random::details::mul_wide(bits, width).hi;
+
+                return static_cast<T>(static_cast<U>(offset) + static_cast<U>(low));
+            }
+        }
+
+        template <NumericDatasetElement T>
+        void fill_dataset_chunk(std::span<T> chunk, random::PCG rnd, T low, T high)
+        {
+            constexpr size_t draws = draws_per_element<T>;
+
+            std::array<uint32_t, 4096> raw;
+
+            while (!chunk.empty())
+            {
+                const size_t count = std::min(chunk.size(), raw.size() / draws);
+                rnd.fill(std::span{raw}.first(count * draws));
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const uint64_t bits = draws == 1 ? raw[i] : (uint64_t{raw[2 * i]} << 32) | raw[2 * i + 1];
+                    chunk[i] = map_to_range(bits, low, high);
+                }
+
+                chunk = chunk.subspan(count);
+            }
+        }
+    } // namespace details
+
+    // fills data with uniformly distributed values from [low; high) - the result depends only on the seed,
+    // not on the number of threads: every chunk jumps ahead to its own position in one PCG stream
+    template <NumericDatasetElement T>
+    void fill_numeric_dataset(std::span<T> data, uint32_t seed = 42, std::type_identity_t<T> low = -100, std::type_identity_t<T> high = 100,
+        unsigned max_threads = std::thread::hardware_concurrency())
+    {
+        constexpr size_t min_chunk_size = 1 << 14;
+
+        const size_t chunk_count = std::clamp<size_t>(data.size() / min_chunk_size, 1, std::max(max_threads, 1u));
+        const size_t chunk_size = (data.size() + chunk_count - 1) / chunk_count;
+
+        auto fill_chunk = [=](size_t chunk_index) {
+            const size_t offset = std::min(chunk_index * chunk_size, data.size());
+
+            random::PCG rnd{seed};
+            rnd.advance(offset * details::draws_per_element<T>);
+
+            details::fill_dataset_chunk(data.subspan(offset, std::min(chunk_size, data.size() - offset)), rnd, low, high);
+        };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(chunk_count - 1);
+
+        for (size_t chunk_index = 1; chunk_index < chunk_count; ++chunk_index)
+            workers.emplace_back(fill_chunk, chunk_index);
+
+        fill_chunk(0);
+    }
+
+    // runtime-sized dataset allocated with the given memory resource
+    template <NumericDatasetElement T = int>
+    [[nodiscard]] std::pmr::vector<T> create_numeric_dataset(size_t size, uint32_t seed = 42, std::type_identity_t<T> low = -100, std::type_identity_t<T> high = 100,
+        std::pmr::memory_resource* mem_resource = std::pmr::get_default_resource())
+    {
+        std::pmr::vector<T> data(size, mem_resource);
+        fill_numeric_dataset(std::span{data}, seed, low, high);
 
-        return result_data;
+        return data;
     }
 } // namespace helpers
 
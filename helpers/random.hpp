@@ -1,12 +1,66 @@
 #ifndef RANDOM_HPP
 #define RANDOM_HPP
 
-#include <utility>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <numeric>
+#include <span>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 namespace helpers::random
 {
+    namespace details
+    {
+        inline constexpr std::uint64_t pcg_multiplier = 6364126223846793005ULL;
+
+        // output function (XSH RR) - takes state before the advance
+        constexpr std::uint32_t pcg_output(std::uint64_t old_state)
+        {
+            std::uint32_t xor_shifted = ((old_state >> 18u) ^ old_state) >> 27u;
+            std::uint32_t rot = old_state >> 59u;
+
+            return (xor_shifted >> rot) | (xor_shifted << ((-rot) & 31));
+        }
+
+        struct LcgJump
+        {
+            std::uint64_t mult = 1;
+            std::uint64_t plus = 0;
+        };
+
+        // coefficients of delta LCG steps (state' = mult * state + plus) in O(log delta) - F. Brown, "Random Number Generation with Arbitrary Stride"
+        constexpr LcgJump lcg_jump(std::uint64_t delta, std::uint64_t inc)
+        {
+            LcgJump acc{};
+            std::uint64_t cur_mult = pcg_multiplier;
+            std::uint64_t cur_plus = inc;
+
+            while (delta > 0)
+            {
+                if (delta & 1)
+                {
+                    acc.mult *= cur_mult;
+                    acc.plus = acc.plus * cur_mult + cur_plus;
+                }
+
+                cur_plus = (cur_mult + 1) * cur_plus;
+                cur_mult *= cur_mult;
+                delta /= 2;
+            }
+
+            return acc;
+        }
+    } // namespace details
+
+    template <std::size_t Lanes>
+    struct PCGLanes;
+
     struct PCG
     {
         struct pcg_32t_random_t
@@ -19,8 +73,10 @@ namespace helpers::random
 
         using result_type = std::uint32_t;
 
+        static constexpr std::size_t default_lanes = 16;
+
         constexpr explicit PCG(std::uint64_t seed) : rng{.state=seed}
-        {            
+        {
         }
 
         constexpr result_type operator()()
@@ -28,6 +84,27 @@ namespace helpers::random
             return pcg32_random_r();
         }
 
+        // fills out with the next out.size() values of the stream - same result as std::ranges::generate(out, *this)
+        template <std::size_t Lanes = default_lanes>
+        constexpr void fill(std::span<result_type> out);
+
+        // jumps delta steps ahead in O(log delta); the period is 2^64, so advance(-n) goes n steps back
+        constexpr void advance(std::uint64_t delta)
+        {
+            const auto [mult, plus] = details::lcg_jump(delta, rng.inc | 1);
+            rng.state = mult * rng.state + plus;
+        }
+
+        // generator for another stream (selected by the increment) starting at the same state;
+        // PCG{seed} is stream 0 - the increment is odd, so there are 2^63 streams: ids below 2^63 never
+        // produce the same sequence (the top bit is dropped - ids k and k + 2^63 select the same stream)
+        constexpr PCG split(std::uint64_t stream_id) const
+        {
+            PCG result{*this};
+            result.rng.inc = stream_id << 1u;
+            return result;
+        }
+
         static constexpr result_type min()
         {
             return std::numeric_limits<result_type>::min();
@@ -44,15 +121,183 @@ namespace helpers::random
             std::uint64_t old_state = rng.state;
 
             // advance internal state
-            rng.state = old_state * 6364126223846793005ULL + (rng.inc | 1);
+            rng.state = old_state * details::pcg_multiplier + (rng.inc | 1);
 
             // calculate output function (XHS RR), uses old state for max ILP
-            std::uint32_t xor_shifted = ((old_state >> 18u) ^ old_state) >> 27u;
-            std::uint32_t rot = old_state >> 59u;
+            return details::pcg_output(old_state);
+        }
+    };
 
-            return (xor_shifted >> rot) | (xor_shifted << ((-rot) & 31));
+    namespace details
+    {
+#if defined(__AVX2__)
+        // low 64 bits of a * b - AVX2 has no 64-bit mullo
+        inline __m256i mullo_epi64(__m256i a, __m256i b)
+        {
+            const __m256i lo = _mm256_mul_epu32(a, b);
+            const __m256i cross = _mm256_add_epi64(
+                _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+        }
+
+        inline __m128i pcg_output_avx2(__m256i state)
+        {
+            const __m256i xor_shifted = _mm256_and_si256(
+                _mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(state, 18), state), 27),
+                _mm256_set1_epi64x(0xFFFF'FFFF));
+            const __m256i rot = _mm256_srli_epi64(state, 59);
+            const __m256i rot_left = _mm256_and_si256(_mm256_sub_epi64(_mm256_setzero_si256(), rot), _mm256_set1_epi64x(31));
+
+            const __m256i result = _mm256_or_si256(_mm256_srlv_epi64(xor_shifted, rot), _mm256_sllv_epi64(xor_shifted, rot_left));
+
+            // gather low halves of 64-bit lanes
+            return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(result, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+        }
+
+        template <std::size_t Lanes>
+        void pcg_fill_avx2(std::uint64_t* states, std::uint64_t mult, std::uint64_t inc, std::uint32_t* out, std::size_t rounds)
+        {
+            constexpr std::size_t regs = Lanes / 4;
+
+            __m256i s[regs];
+            for (std::size_t r = 0; r < regs; ++r)
+                s[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + 4 * r));
+
+            const __m256i m = _mm256_set1_epi64x(static_cast<long long>(mult));
+            const __m256i c = _mm256_set1_epi64x(static_cast<long long>(inc));
+
+            for (std::size_t i = 0; i < rounds; ++i, out += Lanes)
+            {
+                for (std::size_t r = 0; r < regs; ++r)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * r), pcg_output_avx2(s[r]));
+                    s[r] = _mm256_add_epi64(mullo_epi64(s[r], m), c);
+                }
+            }
+
+            for (std::size_t r = 0; r < regs; ++r)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + 4 * r), s[r]);
+        }
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+        inline __m256i pcg_output_avx512(__m512i state)
+        {
+            const __m512i xor_shifted = _mm512_and_si512(
+                _mm512_srli_epi64(_mm512_xor_si512(_mm512_srli_epi64(state, 18), state), 27),
+                _mm512_set1_epi64(0xFFFF'FFFF));
+            const __m512i rot = _mm512_srli_epi64(state, 59);
+            const __m512i rot_left = _mm512_and_si512(_mm512_sub_epi64(_mm512_setzero_si512(), rot), _mm512_set1_epi64(31));
+
+            return _mm512_cvtepi64_epi32(_mm512_or_si512(_mm512_srlv_epi64(xor_shifted, rot), _mm512_sllv_epi64(xor_shifted, rot_left)));
+        }
+
+        template <std::size_t Lanes>
+        void pcg_fill_avx512(std::uint64_t* states, std::uint64_t mult, std::uint64_t inc, std::uint32_t* out, std::size_t rounds)
+        {
+            constexpr std::size_t regs = Lanes / 8;
+
+            __m512i s[regs];
+            for (std::size_t r = 0; r < regs; ++r)
+                s[r] = _mm512_loadu_si512(states + 8 * r);
+
+            const __m512i m = _mm512_set1_epi64(static_cast<long long>(mult));
+            const __m512i c = _mm512_set1_epi64(static_cast<long long>(inc));
+
+            for (std::size_t i = 0; i < rounds; ++i, out += Lanes)
+            {
+                for (std::size_t r = 0; r < regs; ++r)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * r), pcg_output_avx512(s[r]));
+                    s[r] = _mm512_add_epi64(_mm512_mullo_epi64(s[r], m), c);
+                }
+            }
+
+            for (std::size_t r = 0; r < regs; ++r)
+                _mm512_storeu_si512(states + 8 * r, s[r]);
+        }
+#endif
+    } // namespace details
+
+    // Lanes interleaved copies of one PCG stream: lane i starts i steps ahead and jumps Lanes steps at a time,
+    // so a round of all lanes yields the next Lanes values of the scalar stream in order
+    template <std::size_t Lanes>
+    struct PCGLanes
+    {
+        static_assert(Lanes == 4 || Lanes == 8 || Lanes == 16, "supported lane layouts: 4, 8 or 16");
+
+        std::array<std::uint64_t, Lanes> states{};
+        std::uint64_t inc = 0;
+        details::LcgJump step; // Lanes steps of the scalar stream
+
+        constexpr explicit PCGLanes(const PCG& pcg)
+            : inc{pcg.rng.inc}
+            , step{details::lcg_jump(Lanes, pcg.rng.inc | 1)}
+        {
+            const std::uint64_t c = pcg.rng.inc | 1;
+
+            std::uint64_t state = pcg.rng.state;
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                states[i] = state;
+                state = state * details::pcg_multiplier + c;
+            }
+        }
+
+        // fills the longest prefix of out that is a multiple of Lanes; returns number of written values
+        constexpr std::size_t fill(std::span<std::uint32_t> out)
+        {
+            const std::size_t rounds = out.size() / Lanes;
+
+            if !consteval
+            {
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+                if constexpr (Lanes % 8 == 0)
+                {
+                    details::pcg_fill_avx512<Lanes>(states.data(), step.mult, step.plus, out.data(), rounds);
+                    return rounds * Lanes;
+                }
+#endif
+#if defined(__AVX2__)
+                details::pcg_fill_avx2<Lanes>(states.data(), step.mult, step.plus, out.data(), rounds);
+                return rounds * Lanes;
+#endif
+            }
+
+            for (std::size_t i = 0; i < rounds; ++i)
+            {
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    out[i * Lanes + lane] = details::pcg_output(states[lane]);
+                    states[lane] = states[lane] * step.mult + step.plus;
+                }
+            }
+
+            return rounds * Lanes;
+        }
+
+        // scalar generator positioned where the next round would start
+        constexpr PCG to_scalar() const
+        {
+            PCG pcg{states[0]};
+            pcg.rng.inc = inc;
+            return pcg;
         }
     };
+
+    template <std::size_t Lanes>
+    constexpr void PCG::fill(std::span<result_type> out)
+    {
+        PCGLanes<Lanes> lanes{*this};
+        const std::size_t vectorized = lanes.fill(out);
+
+        rng = lanes.to_scalar().rng;
+
+        for (auto& item : out.subspan(vectorized))
+            item = pcg32_random_r();
+    }
 } // namespace helpers::random
 
-#endif
\ No newline at end of file
+#endif
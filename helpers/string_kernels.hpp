@@ -0,0 +1,361 @@
+#ifndef STRING_KERNELS_HPP
+#define STRING_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#define HELPERS_SIMD_STRINGS 1
+#endif
+
+namespace helpers::strings
+{
+    inline constexpr std::size_t npos = std::string_view::npos;
+
+    namespace details
+    {
+        // scalar kernels - used in constant evaluation, for tails and where no SIMD is available
+
+        constexpr std::size_t length_scalar(const char* text)
+        {
+            std::size_t length = 0;
+            while (text[length] != '\0')
+                ++length;
+            return length;
+        }
+
+        constexpr bool is_any_of(char c, std::string_view chars)
+        {
+            for (char candidate : chars)
+            {
+                if (c == candidate)
+                    return true;
+            }
+            return false;
+        }
+
+        // isspace in the "C" locale: ' ', '\t', '\n', '\v', '\f', '\r'
+        constexpr bool is_whitespace(char c)
+        {
+            return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+        }
+
+        constexpr char to_upper(char c)
+        {
+            return static_cast<unsigned char>(c - 'a') <= 'z' - 'a' ? static_cast<char>(c - ('a' - 'A')) : c;
+        }
+
+        constexpr char to_lower(char c)
+        {
+            return static_cast<unsigned char>(c - 'A') <= 'Z' - 'A' ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+        template <typename Predicate>
+        constexpr std::size_t find_if_scalar(std::string_view text, std::size_t pos, Predicate predicate)
+        {
+            for (; pos < text.size(); ++pos)
+            {
+                if (predicate(text[pos]))
+                    return pos;
+            }
+            return npos;
+        }
+
+#if defined(__AVX2__)
+        // one register of 32 chars - comparisons give 0xFF in matching bytes, movemask packs them to bits
+        struct Simd
+        {
+            using Vector = __m256i;
+            static constexpr std::size_t width = 32;
+
+            static Vector load(const char* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+            static Vector loadu(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void storeu(char* p, Vector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static Vector broadcast(char c) { return _mm256_set1_epi8(c); }
+            static Vector equal(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+            static Vector less(Vector a, Vector b) { return _mm256_cmpgt_epi8(b, a); } // signed
+            static Vector add(Vector a, Vector b) { return _mm256_add_epi8(a, b); }
+            static Vector bit_or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+            static Vector bit_and(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+            static Vector bit_xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+            static std::uint32_t mask(Vector v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+        };
+#elif defined(__SSE2__)
+        struct Simd
+        {
+            using Vector = __m128i;
+            static constexpr std::size_t width = 16;
+
+            static Vector load(const char* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+            static Vector loadu(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void storeu(char* p, Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static Vector broadcast(char c) { return _mm_set1_epi8(c); }
+            static Vector equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+            static Vector less(Vector a, Vector b) { return _mm_cmplt_epi8(a, b); } // signed
+            static Vector add(Vector a, Vector b) { return _mm_add_epi8(a, b); }
+            static Vector bit_or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+            static Vector bit_and(Vector a, Vector b) { return _mm_and_si128(a, b); }
+            static Vector bit_xor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+            static std::uint32_t mask(Vector v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+        };
+#endif
+
+#if defined(HELPERS_SIMD_STRINGS)
+        inline constexpr std::size_t unroll = 4;
+
+        // position of the first char for which match(chars) has a set byte
+        template <typename Match, typename Predicate>
+        std::size_t find_simd(std::string_view text, std::size_t pos, Match match, Predicate predicate)
+        {
+            const std::size_t size = text.size();
+            if (pos >= size)
+                return npos;
+            if (size < Simd::width)
+                return find_if_scalar(text, pos, predicate);
+
+            const char* data = text.data();
+
+            for (; pos + unroll * Simd::width <= size; pos += unroll * Simd::width)
+            {
+                Simd::Vector found[unroll];
+                for (std::size_t i = 0; i < unroll; ++i)
+                    found[i] = match(Simd::loadu(data + pos + i * Simd::width));
+
+                if (Simd::mask(Simd::bit_or(Simd::bit_or(found[0], found[1]), Simd::bit_or(found[2], found[3]))) == 0)
+                    continue;
+
+                for (std::size_t i = 0; i < unroll; ++i)
+                {
+                    if (const std::uint32_t bits = Simd::mask(found[i]); bits != 0)
+                        return pos + i * Simd::width + std::countr_zero(bits);
+                }
+            }
+
+            for (; pos + Simd::width <= size; pos += Simd::width)
+            {
+                if (const std::uint32_t bits = Simd::mask(match(Simd::loadu(data + pos))); bits != 0)
+                    return pos + std::countr_zero(bits);
+            }
+
+            // the tail - one register ending at the end of text, chars already checked are shifted out
+            if (pos < size)
+            {
+                const std::size_t last = size - Simd::width;
+                if (const std::uint32_t bits = Simd::mask(match(Simd::loadu(data + last))) >> (pos - last); bits != 0)
+                    return pos + std::countr_zero(bits);
+            }
+
+            return npos;
+        }
+
+        // signed compare trick - chars in [first, last] become the lowest (last - first + 1) signed values
+        inline Simd::Vector in_range(Simd::Vector chars, char first, char last)
+        {
+            const auto shifted = Simd::add(chars, Simd::broadcast(static_cast<char>(-128 - first)));
+            return Simd::less(shifted, Simd::broadcast(static_cast<char>(-128 + (last - first + 1))));
+        }
+
+        inline Simd::Vector whitespace_mask(Simd::Vector chars)
+        {
+            return Simd::bit_or(Simd::equal(chars, Simd::broadcast(' ')), in_range(chars, '\t', '\r'));
+        }
+
+        // flips bit 0x20 of chars in [first, last]
+        inline void flip_case_simd(std::span<char> text, char first, char last, char (*convert_scalar)(char))
+        {
+            const auto case_bit = Simd::broadcast(0x20);
+
+            std::size_t pos = 0;
+            for (; pos + Simd::width <= text.size(); pos += Simd::width)
+            {
+                const auto chars = Simd::loadu(text.data() + pos);
+                Simd::storeu(text.data() + pos, Simd::bit_xor(chars, Simd::bit_and(in_range(chars, first, last), case_bit)));
+            }
+
+            for (char& c : text.subspan(pos))
+                c = convert_scalar(c);
+        }
+#endif
+    } // namespace details
+
+    // strlen & memchr of the C library are SIMD kernels already, dispatched to AVX2/AVX-512 at runtime -
+    // a kernel fixed at compile time was 2-3x slower (see the benchmark), so the runtime paths use them
+
+    constexpr std::size_t length(const char* text)
+    {
+        if !consteval
+        {
+            return std::char_traits<char>::length(text);
+        }
+        return details::length_scalar(text);
+    }
+
+    // position of the first c at or after pos, npos if there is none
+    constexpr std::size_t find(std::string_view text, char c, std::size_t pos = 0)
+    {
+        if !consteval
+        {
+            if (pos >= text.size())
+                return npos;
+
+            const char* found = std::char_traits<char>::find(text.data() + pos, text.size() - pos, c);
+            return found != nullptr ? static_cast<std::size_t>(found - text.data()) : npos;
+        }
+        return details::find_if_scalar(text, pos, [c](char x) { return x == c; });
+    }
+
+    // position of the first char that is any of delimiters - up to 8 delimiters are compared in registers,
+    // longer sets fall back to a byte table
+    constexpr std::size_t find_any(std::string_view text, std::string_view delimiters, std::size_t pos = 0)
+    {
+        if (delimiters.size() == 1)
+            return find(text, delimiters[0], pos);
+
+#if defined(HELPERS_SIMD_STRINGS)
+        if !consteval
+        {
+            if (delimiters.empty())
+                return npos;
+
+            if (delimiters.size() <= 8)
+            {
+                details::Simd::Vector needles[8];
+                for (std::size_t i = 0; i < std::size(needles); ++i)
+                    needles[i] = details::Simd::broadcast(delimiters[std::min(i, delimiters.size() - 1)]); // repeats the last one
+
+                return details::find_simd(
+                    text, pos,
+                    [&needles](auto chars) {
+                        auto found = details::Simd::equal(chars, needles[0]);
+                        for (std::size_t i = 1; i < std::size(needles); ++i)
+                            found = details::Simd::bit_or(found, details::Simd::equal(chars, needles[i]));
+                        return found;
+                    },
+                    [delimiters](char c) { return details::is_any_of(c, delimiters); });
+            }
+
+            std::array<bool, 256> is_delimiter{};
+            for (char c : delimiters)
+                is_delimiter[static_cast<unsigned char>(c)] = true;
+
+            return details::find_if_scalar(text, pos, [&is_delimiter](char c) { return is_delimiter[static_cast<unsigned char>(c)]; });
+        }
+#endif
+        return details::find_if_scalar(text, pos, [delimiters](char c) { return details::is_any_of(c, delimiters); });
+    }
+
+    constexpr std::size_t find_whitespace(std::string_view text, std::size_t pos = 0)
+    {
+#if defined(HELPERS_SIMD_STRINGS)
+        if !consteval
+        {
+            return details::find_simd(text, pos, details::whitespace_mask, details::is_whitespace);
+        }
+#endif
+        return details::find_if_scalar(text, pos, details::is_whitespace);
+    }
+
+    constexpr std::size_t find_non_whitespace(std::string_view text, std::size_t pos = 0)
+    {
+        const auto is_not_whitespace = [](char c) { return !details::is_whitespace(c); };
+
+#if defined(HELPERS_SIMD_STRINGS)
+        if !consteval
+        {
+            const auto all_ones = details::Simd::broadcast(static_cast<char>(0xFF));
+            return details::find_simd(
+                text, pos, [all_ones](auto chars) { return details::Simd::bit_xor(details::whitespace_mask(chars), all_ones); },
+                is_not_whitespace);
+        }
+#endif
+        return details::find_if_scalar(text, pos, is_not_whitespace);
+    }
+
+    // text without leading and trailing whitespace
+    constexpr std::string_view trim(std::string_view text)
+    {
+        const std::size_t first = find_non_whitespace(text);
+        if (first == npos)
+            return {};
+
+        std::size_t last = text.size();
+        while (details::is_whitespace(text[last - 1]))
+            --last;
+
+        return text.substr(first, last - first);
+    }
+
+    // text before and after the first separator - {"", ""} if there is no separator
+    constexpr std::pair<std::string_view, std::string_view> split_once(std::string_view text, char separator)
+    {
+        const std::size_t pos = find(text, separator);
+        if (pos == npos)
+            return {};
+
+        return {text.substr(0, pos), text.substr(pos + 1)};
+    }
+
+    // calls on_token(token) for every (possibly empty) token between delimiters
+    template <typename OnToken>
+    constexpr void split(std::string_view text, std::string_view delimiters, OnToken&& on_token)
+    {
+        std::size_t start = 0;
+        for (std::size_t pos = find_any(text, delimiters); pos != npos; pos = find_any(text, delimiters, start))
+        {
+            on_token(text.substr(start, pos - start));
+            start = pos + 1;
+        }
+        on_token(text.substr(start));
+    }
+
+    // ASCII case conversion in place - other bytes (including UTF-8 sequences) are left untouched
+    constexpr void to_upper(std::span<char> text)
+    {
+#if defined(HELPERS_SIMD_STRINGS)
+        if !consteval
+        {
+            details::flip_case_simd(text, 'a', 'z', details::to_upper);
+            return;
+        }
+#endif
+        for (char& c : text)
+            c = details::to_upper(c);
+    }
+
+    constexpr void to_lower(std::span<char> text)
+    {
+#if defined(HELPERS_SIMD_STRINGS)
+        if !consteval
+        {
+            details::flip_case_simd(text, 'A', 'Z', details::to_lower);
+            return;
+        }
+#endif
+        for (char& c : text)
+            c = details::to_lower(c);
+    }
+
+    constexpr std::string to_upper_copy(std::string_view text)
+    {
+        std::string result{text};
+        to_upper(result);
+        return result;
+    }
+
+    constexpr std::string to_lower_copy(std::string_view text)
+    {
+        std::string result{text};
+        to_lower(result);
+        return result;
+    }
+} // namespace helpers::strings
+
+#endif
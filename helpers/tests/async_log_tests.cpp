@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <async_log.hpp>
+#include <binary_log.hpp>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+using namespace helpers::log;
+
+namespace
+{
+    std::string read_all(std::FILE* file)
+    {
+        std::fflush(file);
+        std::rewind(file);
+
+        std::string content;
+        char buffer[4096];
+        while (size_t count = std::fread(buffer, 1, sizeof(buffer), file))
+            content.append(buffer, count);
+
+        return content;
+    }
+
+    template <typename F>
+    void print_latencies(std::string_view name, size_t count, F write_message)
+    {
+        std::vector<std::chrono::nanoseconds> latencies(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            write_message(i);
+            latencies[i] = std::chrono::steady_clock::now() - start;
+        }
+
+        std::ranges::sort(latencies);
+        std::cout << std::format("{:<24} p50: {:>6} ns  p99: {:>6} ns  max: {:>9} ns\n", name, latencies[count / 2].count(),
+            latencies[count * 99 / 100].count(), latencies.back().count());
+    }
+} // namespace
+
+TEST_CASE("SpscRing")
+{
+    SpscRing ring{10};
+    REQUIRE(ring.capacity() == 16);
+
+    std::string drained;
+    auto drain = [&] {
+        drained.clear();
+        ring.drain([&](std::string_view bytes) { drained += bytes; });
+        return drained;
+    };
+
+    CHECK(ring.try_push("0123456789"));
+    CHECK_FALSE(ring.try_push("abcdefg")); // all or nothing
+    CHECK(drain() == "0123456789");
+    CHECK(ring.empty());
+
+    SECTION("wraps around")
+    {
+        CHECK(ring.try_push("abcdefghijklmnop"));
+        CHECK_FALSE(ring.try_push("x"));
+        CHECK(drain() == "abcdefghijklmnop");
+        CHECK(drain() == "");
+    }
+}
+
+TEST_CASE("AsyncBackend")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+
+    constexpr int thread_count = 4;
+    constexpr int messages_per_thread = 20'000;
+
+    SECTION("messages from many threads - none lost, order kept per thread")
+    {
+        {
+            AsyncBackend backend{{.fd = fileno(file), .ring_capacity = 1024, .flush_interval = 100us}};
+
+            std::vector<std::jthread> threads;
+            for (int id = 0; id < thread_count; ++id)
+            {
+                threads.emplace_back([&backend, id] {
+                    for (int i = 0; i < messages_per_thread; ++i)
+                        backend.write(std::format("{} {}\n", id, i));
+                });
+            }
+        } // threads joined, backend flushed
+
+        std::istringstream lines{read_all(file)};
+        std::map<int, int> next_message;
+        int id, i;
+        while (lines >> id >> i)
+        {
+            REQUIRE(next_message[id] == i);
+            ++next_message[id];
+        }
+
+        REQUIRE(next_message.size() == thread_count);
+        for (const auto& [id, count] : next_message)
+            REQUIRE(count == messages_per_thread);
+    }
+
+    SECTION("flush makes everything written so far visible")
+    {
+        AsyncBackend backend{{.fd = fileno(file), .flush_interval = 1h}};
+
+        backend.write("first\n");
+        std::jthread{[&backend] { backend.write("second\n"); }}.join();
+        backend.flush();
+        CHECK(backend.flush() == 0); // nothing left to write
+
+        const std::string content = read_all(file);
+        CHECK(content == "first\nsecond\n");
+        CHECK(backend.bytes_written() == content.size());
+    }
+
+    SECTION("message longer than the ring - written whole, after the messages queued before")
+    {
+        const std::string long_message = std::string(3'000, 'x') + "\n";
+
+        {
+            AsyncBackend backend{{.fd = fileno(file), .ring_capacity = 1024, .flush_interval = 1h}};
+
+            backend.write("first\n");
+            backend.write(long_message);
+            backend.write("last\n");
+        }
+
+        CHECK(read_all(file) == "first\n" + long_message + "last\n");
+    }
+
+    std::fclose(file);
+}
+
+TEST_CASE("AsyncBackend & BinaryLog - latency vs synchronous writes", "[.][benchmark]")
+{
+    constexpr size_t count = 200'000;
+
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const int fd = fileno(file);
+
+    std::string line;
+    auto format_line = [&line](size_t i) -> std::string_view {
+        line.clear();
+        std::format_to(std::back_inserter(line), "[info] main_logger: message #{} value: {}\n", i, i * 0.5);
+        return line;
+    };
+
+    print_latencies("fwrite + fflush", count, [&](size_t i) {
+        const auto message = format_line(i);
+        std::fwrite(message.data(), 1, message.size(), file);
+        std::fflush(file);
+    });
+
+    print_latencies("details::write_all", count, [&](size_t i) {
+        helpers::details::write_all(fd, format_line(i));
+    });
+
+    AsyncBackend backend{{.fd = fd}};
+    print_latencies("AsyncBackend::write", count, [&](size_t i) {
+        backend.write(format_line(i));
+    });
+    backend.flush();
+
+    // formatting deferred to the decoder
+    BinaryLog binary_log{{.fd = fd}};
+    print_latencies("BinaryLog::write", count, [&](size_t i) {
+        binary_log.write<Level::info, "main_logger", "message #{} value: {}">(i, i * 0.5);
+    });
+    binary_log.flush();
+
+    std::fclose(file);
+}
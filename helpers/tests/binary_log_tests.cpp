@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include <binary_log.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+using namespace helpers::log;
+
+namespace
+{
+    std::string read_all(std::FILE* file)
+    {
+        std::fflush(file);
+        std::rewind(file);
+
+        std::string content;
+        char buffer[4096];
+        while (size_t count = std::fread(buffer, 1, sizeof(buffer), file))
+            content.append(buffer, count);
+
+        return content;
+    }
+
+    std::string decode(std::string_view log)
+    {
+        std::ostringstream out;
+        decode_binary_log(log, out);
+        return out.str();
+    }
+
+    // hand-made log with one site and one event of that site
+    std::string make_log(std::string_view format, std::vector<ArgType> arg_types, std::string_view payload)
+    {
+        std::string log{helpers::log::details::header};
+        helpers::log::details::append_site(log, 0, {Level::info, "main", format, arg_types});
+
+        const auto put_value = [&log](auto value) { log.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        put_value(helpers::log::details::RecordKind::event);
+        put_value(uint32_t{0});
+        put_value(static_cast<uint32_t>(payload.size()));
+        log += payload;
+
+        return log;
+    }
+} // namespace
+
+TEST_CASE("BinaryLog - decoded log matches std::format")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+
+    {
+        BinaryLog log{{.fd = fileno(file)}};
+
+        const std::string name = "Jan";
+        log.write<Level::info, "main", "Start">();
+        log.write<Level::debug, "main", "{} + {} = {}">(2, 3u, 5LL);
+        log.write<Level::warning, "db", "pi ~ {:.3f}, ratio {:>8.2e}">(3.14159, 0.5f);
+        log.write<Level::error, "db", "user '{}' ({}) - {} {} {}">(name, "guest", std::string_view{"sv"}, true, 'x');
+        log.write<Level::info, "main", "{1}-{0} {{literal}} {0:#x} {2:*^7}">(255, -1, "mid");
+    }
+
+    const std::string expected = std::format("[info] main: Start\n"
+                                             "[debug] main: 2 + 3 = 5\n"
+                                             "[warning] db: pi ~ {:.3f}, ratio {:>8.2e}\n"
+                                             "[error] db: user 'Jan' (guest) - sv true x\n"
+                                             "[info] main: -1-255 {{literal}} 0xff **mid**\n",
+        3.14159, 0.5);
+
+    CHECK(decode(read_all(file)) == expected);
+
+    std::fclose(file);
+}
+
+TEST_CASE("BinaryLog - many threads")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+
+    constexpr int thread_count = 4;
+    constexpr int messages_per_thread = 10'000;
+
+    {
+        BinaryLog log{{.fd = fileno(file), .ring_capacity = 1024, .flush_interval = 100us}};
+
+        std::vector<std::jthread> threads;
+        for (int id = 0; id < thread_count; ++id)
+        {
+            threads.emplace_back([&log, id] {
+                for (int i = 0; i < messages_per_thread; ++i)
+                {
+                    if (i % 2 == 0)
+                        log.write<Level::info, "worker", "{} {}">(id, i);
+                    else
+                        log.write<Level::info, "worker", "{} {} odd">(id, i);
+                }
+            });
+        }
+    }
+
+    std::istringstream lines{decode(read_all(file))};
+    std::vector<int> next_message(thread_count);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        int id, i;
+        REQUIRE(std::sscanf(line.c_str(), "[info] worker: %d %d", &id, &i) == 2);
+        REQUIRE(next_message[id] == i);
+        REQUIRE(line.ends_with(" odd") == (i % 2 == 1));
+        ++next_message[id];
+    }
+
+    REQUIRE(next_message == std::vector<int>(thread_count, messages_per_thread));
+
+    std::fclose(file);
+}
+
+TEST_CASE("BinaryLog - record longer than the ring")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+
+    const std::string long_text(5'000, 'x');
+
+    {
+        BinaryLog log{{.fd = fileno(file), .ring_capacity = 1024}};
+
+        log.write<Level::info, "main", "before {}">(1);
+        log.write<Level::warning, "main", "long {} text {}">(long_text, 2);
+        log.write<Level::info, "main", "after {}">(3);
+    }
+
+    CHECK(decode(read_all(file)) == "[info] main: before 1\n[warning] main: long " + long_text + " text 2\n[info] main: after 3\n");
+
+    std::fclose(file);
+}
+
+TEST_CASE("BinaryLog - malformed input")
+{
+    CHECK_THROWS_AS(decode("text log\n"), std::runtime_error);
+    CHECK_THROWS_AS(decode("HLOG\x01\x01\x07"sv), std::runtime_error); // truncated event
+    CHECK(decode("HLOG\x01"sv) == "");
+
+    const std::string int_payload(8, '\0');
+    CHECK(decode(make_log("x{}", {ArgType::signed_integer}, int_payload)) == "[info] main: x0\n");
+
+    CHECK_THROWS_AS(decode(make_log("x{}", {}, "")), std::runtime_error);                           // more fields than arguments
+    CHECK_THROWS_AS(decode(make_log("x{5}", {ArgType::signed_integer}, int_payload)), std::runtime_error);
+    CHECK_THROWS_AS(decode(make_log("x{a}", {ArgType::signed_integer}, int_payload)), std::runtime_error);
+    CHECK_THROWS_AS(decode(make_log("abc{", {}, "")), std::runtime_error);                          // unterminated field
+    CHECK_THROWS_AS(decode(make_log("abc}", {}, "")), std::runtime_error);
+    CHECK_THROWS_AS(decode(make_log("{:{}}", {ArgType::signed_integer, ArgType::signed_integer}, int_payload + int_payload)),
+        std::runtime_error);                                                                          // nested field
+    CHECK_THROWS_AS(decode(make_log("x{}", {ArgType::signed_integer}, int_payload + "extra")), std::runtime_error); // payload not consumed
+
+    static_assert(helpers::log::details::has_nested_replacement_field("{:{}}"));
+    static_assert(helpers::log::details::has_nested_replacement_field("{} {0:>{1}}"));
+    static_assert(!helpers::log::details::has_nested_replacement_field("{{}} {:>8} {0}"));
+}
@@ -0,0 +1,179 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <dataset_cache.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct TempCacheDir
+    {
+        fs::path path = fs::temp_directory_path() / "helpers-dataset-cache-tests";
+
+        TempCacheDir()
+        {
+            fs::remove_all(path);
+        }
+
+        ~TempCacheDir()
+        {
+            fs::remove_all(path);
+        }
+    };
+
+    fs::path single_cache_file(const fs::path& dir)
+    {
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator{dir})
+            files.push_back(entry.path());
+
+        REQUIRE(files.size() == 1);
+        return files.front();
+    }
+
+    void overwrite_byte(const fs::path& path, std::streamoff offset, char value)
+    {
+        std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(offset);
+        file.put(value);
+    }
+} // namespace
+
+TEST_CASE("DatasetCache")
+{
+    TempCacheDir temp_dir;
+    helpers::DatasetCache cache{temp_dir.path};
+
+    std::vector<int> expected(10'000);
+    helpers::fill_numeric_dataset(std::span{expected}, 42, 0, 1000);
+
+    SECTION("serves generated data")
+    {
+        auto dataset = cache.get<int>(10'000, 42, 0, 1000);
+
+        CHECK(std::ranges::equal(dataset.data(), expected));
+    }
+
+    SECTION("reuses existing file")
+    {
+        auto first = cache.get<int>(10'000, 42, 0, 1000);
+        const auto file = single_cache_file(temp_dir.path);
+        const auto write_time = fs::last_write_time(file);
+
+        auto second = cache.get<int>(10'000, 42, 0, 1000);
+
+        CHECK(fs::last_write_time(file) == write_time);
+        CHECK(std::ranges::equal(second.data(), expected));
+    }
+
+    SECTION("every parameter is part of the key")
+    {
+        auto ints = cache.get<int>(100, 42, 0, 1000);
+        auto other_seed = cache.get<int>(100, 43, 0, 1000);
+        auto other_size = cache.get<int>(101, 42, 0, 1000);
+        auto other_bounds = cache.get<int>(100, 42, 0, 999);
+        auto other_type = cache.get<int64_t>(100, 42, 0, 1000);
+        auto doubles = cache.get<double>(100, 42, 0.0, 1.0);
+
+        CHECK(std::ranges::distance(fs::directory_iterator{temp_dir.path}, fs::directory_iterator{}) == 6);
+        CHECK(std::ranges::all_of(doubles.data(), [](double x) { return 0.0 <= x && x < 1.0; }));
+    }
+
+    SECTION("corrupted payload is regenerated when checksums are verified")
+    {
+        (void)cache.get<int>(10'000, 42, 0, 1000);
+        overwrite_byte(single_cache_file(temp_dir.path), 100, 'X');
+
+        helpers::DatasetCache verified_cache{temp_dir.path, true};
+        auto dataset = verified_cache.get<int>(10'000, 42, 0, 1000);
+
+        CHECK(std::ranges::equal(dataset.data(), expected));
+    }
+
+    SECTION("truncated file is regenerated")
+    {
+        (void)cache.get<int>(10'000, 42, 0, 1000);
+        fs::resize_file(single_cache_file(temp_dir.path), 1000);
+
+        auto dataset = cache.get<int>(10'000, 42, 0, 1000);
+
+        CHECK(std::ranges::equal(dataset.data(), expected));
+    }
+
+    SECTION("files from other generator versions are purged")
+    {
+        (void)cache.get<int>(100, 1);
+        (void)cache.get<int>(100, 2);
+
+        const auto file = fs::directory_iterator{temp_dir.path}->path();
+        overwrite_byte(file, offsetof(helpers::details::DatasetFileHeader, generator_version), 0x7F);
+
+        CHECK(cache.purge_stale() == 1);
+        CHECK(cache.clear() == 1);
+    }
+
+    SECTION("orphaned temporary files are purged")
+    {
+        (void)cache.get<int>(100);
+        const auto file = single_cache_file(temp_dir.path);
+
+        const fs::path orphaned = file.string() + ".1234-0123456789abcdef.tmp";
+        const fs::path in_progress = file.string() + ".5678-0123456789abcdef.tmp";
+        std::ofstream{orphaned} << "partial";
+        std::ofstream{in_progress} << "partial";
+        fs::last_write_time(orphaned, fs::file_time_type::clock::now() - std::chrono::hours{2});
+
+        CHECK(cache.purge_stale() == 1);
+        CHECK_FALSE(fs::exists(orphaned));
+        CHECK(fs::exists(in_progress));
+    }
+
+    SECTION("concurrent writers of the same dataset")
+    {
+        std::array<bool, 4> served_expected{};
+        {
+            std::vector<std::jthread> writers;
+            for (auto& result : served_expected)
+                writers.emplace_back([&temp_dir, &expected, &result] {
+                    helpers::DatasetCache writer_cache{temp_dir.path, true};
+                    result = std::ranges::equal(writer_cache.get<int>(10'000, 42, 0, 1000).data(), expected);
+                });
+        }
+
+        CHECK(std::ranges::all_of(served_expected, std::identity{}));
+        CHECK(single_cache_file(temp_dir.path).extension() == ".dataset");
+    }
+}
+
+TEST_CASE("DatasetCache - load vs generate", "[.][benchmark]")
+{
+    TempCacheDir temp_dir;
+    helpers::DatasetCache cache{temp_dir.path};
+
+    constexpr size_t size = 10'000'000;
+    (void)cache.get<int>(size);
+
+    BENCHMARK("generate")
+    {
+        return helpers::create_numeric_dataset(size);
+    };
+
+    BENCHMARK("load - header only")
+    {
+        return cache.get<int>(size);
+    };
+
+    helpers::DatasetCache verified_cache{temp_dir.path, true};
+
+    BENCHMARK("load - verified checksum")
+    {
+        return verified_cache.get<int>(size);
+    };
+}
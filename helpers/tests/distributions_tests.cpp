@@ -0,0 +1,279 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <distributions.hpp>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace helpers::random;
+
+namespace
+{
+    template <typename T>
+    std::pair<double, double> mean_and_stddev(const std::vector<T>& values)
+    {
+        const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        const double variance = std::accumulate(values.begin(), values.end(), 0.0, [mean](double acc, T x) { return acc + (x - mean) * (x - mean); })
+            / values.size();
+
+        return {mean, std::sqrt(variance)};
+    }
+} // namespace
+
+TEST_CASE("bounded integers")
+{
+    PCG rnd{42};
+
+    SECTION("mul_wide gives full 128-bit product")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            const uint64_t a = details::next_uint64(rnd);
+            const uint64_t b = details::next_uint64(rnd);
+            const auto product = static_cast<unsigned __int128>(a) * b;
+
+            const auto [hi, lo] = details::mul_wide(a, b);
+            CHECK(hi == static_cast<uint64_t>(product >> 64));
+            CHECK(lo == static_cast<uint64_t>(product));
+        }
+    }
+
+    SECTION("UniformInt covers closed range")
+    {
+        const UniformInt<int> dice{1, 6};
+        std::map<int, int> counts;
+
+        for (int i = 0; i < 60'000; ++i)
+            ++counts[dice(rnd)];
+
+        REQUIRE(counts.size() == 6);
+        CHECK(counts.begin()->first == 1);
+        CHECK(counts.rbegin()->first == 6);
+        CHECK(std::ranges::all_of(counts, [](const auto& kv) { return 9'500 < kv.second && kv.second < 10'500; }));
+    }
+
+    SECTION("range that is not a power of two is not biased")
+    {
+        // with % over 32 bits the first third of [0, 3 * 2^30) would be hit 2x more often
+        const UniformInt<uint32_t> distr{0, 3u * (1u << 30) - 1};
+        std::vector<uint32_t> values(300'000);
+        distr.fill(rnd, values);
+
+        const auto low_third = std::ranges::count_if(values, [](uint32_t x) { return x < (1u << 30); });
+        CHECK(std::abs(low_third - 100'000) < 1'500);
+    }
+
+    SECTION("full and 64-bit ranges")
+    {
+        const UniformInt<int32_t> full{std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()};
+        const UniformInt<int64_t> wide{-5'000'000'000, 5'000'000'000};
+
+        std::vector<int64_t> values(10'000);
+        wide.fill(rnd, values);
+
+        CHECK(std::ranges::all_of(values, [](int64_t x) { return -5'000'000'000 <= x && x <= 5'000'000'000; }));
+        CHECK(std::ranges::any_of(values, [](int64_t x) { return x > std::numeric_limits<int32_t>::max(); }));
+        CHECK(full(rnd) != full(rnd));
+    }
+
+    SECTION("batch fill stays in range")
+    {
+        const UniformInt<short> distr{-3, 3};
+        std::vector<short> values(5'000);
+        distr.fill(rnd, values);
+
+        CHECK(std::ranges::all_of(values, [](short x) { return -3 <= x && x <= 3; }));
+        CHECK(std::ranges::count(values, -3) > 0);
+        CHECK(std::ranges::count(values, 3) > 0);
+    }
+
+    SECTION("works with std::mt19937")
+    {
+        std::mt19937 mt{42};
+        CHECK(bounded(mt, 10) < 10);
+    }
+
+    SECTION("works in constant evaluation")
+    {
+        constexpr auto value = [] {
+            PCG rnd{42};
+            return UniformInt<int>{-10, 10}(rnd);
+        }();
+
+        static_assert(-10 <= value && value <= 10);
+    }
+}
+
+TEST_CASE("uniform floating point values")
+{
+    PCG rnd{42};
+
+    SECTION("canonical is in [0, 1)")
+    {
+        for (int i = 0; i < 10'000; ++i)
+        {
+            const auto f = canonical<float>(rnd);
+            const auto d = canonical<double>(rnd);
+            const auto ld = canonical<long double>(rnd);
+
+            REQUIRE((0.0f <= f && f < 1.0f));
+            REQUIRE((0.0 <= d && d < 1.0));
+            REQUIRE((0.0L <= ld && ld < 1.0L));
+        }
+    }
+
+    SECTION("UniformReal fill")
+    {
+        std::vector<double> doubles(100'000);
+        UniformReal<double>{-1.0, 1.0}.fill(rnd, doubles);
+        CHECK(std::ranges::all_of(doubles, [](double x) { return -1.0 <= x && x < 1.0; }));
+        CHECK(std::abs(mean_and_stddev(doubles).first) < 0.01);
+
+        std::vector<float> floats(100'000);
+        UniformReal<float>{0.0f, 10.0f}.fill(rnd, floats);
+        CHECK(std::ranges::all_of(floats, [](float x) { return 0.0f <= x && x < 10.0f; }));
+        CHECK(std::abs(mean_and_stddev(floats).first - 5.0) < 0.05);
+    }
+
+    SECTION("UniformReal fill matches scalar draws")
+    {
+        auto check_type = []<typename T>(T a, T b) {
+            const UniformReal<T> uniform{a, b};
+
+            PCG batch_rnd{7};
+            std::vector<T> batch(3'000);
+            uniform.fill(batch_rnd, batch);
+
+            PCG scalar_rnd{7};
+            for (T value : batch)
+                REQUIRE(value == uniform(scalar_rnd));
+        };
+
+        check_type(0.0f, 10.0f);
+        check_type(-1.0, 1.0);
+        check_type(-1.0L, 1.0L);
+    }
+}
+
+TEST_CASE("normal distribution")
+{
+    PCG rnd{42};
+    Normal<double> normal{10.0, 2.0};
+
+    SECTION("scalar")
+    {
+        std::vector<double> values(100'000);
+        std::ranges::generate(values, [&] { return normal(rnd); });
+
+        const auto [mean, stddev] = mean_and_stddev(values);
+        CHECK(std::abs(mean - 10.0) < 0.05);
+        CHECK(std::abs(stddev - 2.0) < 0.05);
+    }
+
+    SECTION("batch with odd size")
+    {
+        std::vector<double> values(100'001);
+        normal.fill(rnd, values);
+
+        const auto [mean, stddev] = mean_and_stddev(values);
+        CHECK(std::abs(mean - 10.0) < 0.05);
+        CHECK(std::abs(stddev - 2.0) < 0.05);
+    }
+}
+
+TEST_CASE("Zipf distribution")
+{
+    PCG rnd{42};
+
+    for (double s : {0.5, 1.0, 1.5})
+    {
+        const Zipf zipf{1'000, s};
+
+        std::vector<uint64_t> values(200'000);
+        zipf.fill(rnd, values);
+
+        CHECK(std::ranges::all_of(values, [](uint64_t k) { return 1 <= k && k <= 1'000; }));
+
+        // P(1) / P(2) == 2^s
+        const double ratio = static_cast<double>(std::ranges::count(values, 1)) / std::ranges::count(values, 2);
+        CHECK(std::abs(ratio - std::pow(2.0, s)) < 0.1);
+    }
+
+    SECTION("scalar draws")
+    {
+        const Zipf zipf{10, 1.0};
+        std::vector<uint64_t> values(10'000);
+        std::ranges::generate(values, [&] { return zipf(rnd); });
+
+        CHECK(std::ranges::count(values, 1) > std::ranges::count(values, 10));
+    }
+}
+
+TEST_CASE("distributions - batch vs std", "[.][benchmark]")
+{
+    std::vector<int> ints(1'000'000);
+    std::vector<double> doubles(1'000'000);
+    std::vector<uint64_t> ranks(1'000'000);
+
+    BENCHMARK("ints - modulo")
+    {
+        PCG rnd{42};
+        std::ranges::generate(ints, [&] { return static_cast<int>(rnd() % 1'000u); });
+        return ints.back();
+    };
+
+    BENCHMARK("ints - std::uniform_int_distribution")
+    {
+        PCG rnd{42};
+        std::uniform_int_distribution<int> distr{0, 999};
+        std::ranges::generate(ints, [&] { return distr(rnd); });
+        return ints.back();
+    };
+
+    BENCHMARK("ints - UniformInt::fill")
+    {
+        PCG rnd{42};
+        UniformInt<int>{0, 999}.fill(rnd, ints);
+        return ints.back();
+    };
+
+    BENCHMARK("doubles - std::uniform_real_distribution")
+    {
+        PCG rnd{42};
+        std::uniform_real_distribution<double> distr{0.0, 1.0};
+        std::ranges::generate(doubles, [&] { return distr(rnd); });
+        return doubles.back();
+    };
+
+    BENCHMARK("doubles - UniformReal::fill")
+    {
+        PCG rnd{42};
+        UniformReal<double>{}.fill(rnd, doubles);
+        return doubles.back();
+    };
+
+    BENCHMARK("normal - std::normal_distribution")
+    {
+        PCG rnd{42};
+        std::normal_distribution<double> distr{0.0, 1.0};
+        std::ranges::generate(doubles, [&] { return distr(rnd); });
+        return doubles.back();
+    };
+
+    BENCHMARK("normal - Normal::fill")
+    {
+        PCG rnd{42};
+        Normal<double>{}.fill(rnd, doubles);
+        return doubles.back();
+    };
+
+    BENCHMARK("zipf - Zipf::fill (n = 10^6, s = 1.1)")
+    {
+        PCG rnd{42};
+        Zipf{1'000'000, 1.1}.fill(rnd, ranks);
+        return ranks.back();
+    };
+}
@@ -0,0 +1,172 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <frozen.hpp>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std::literals;
+using namespace helpers::frozen;
+
+namespace
+{
+    enum class RatingValue : uint8_t
+    {
+        very_poor = 1,
+        poor,
+        satisfactory,
+        good,
+        very_good,
+        excellent
+    };
+
+    constexpr std::pair<std::string_view, double> vat_rates[] = {
+        {"at", 0.20}, {"be", 0.21}, {"bg", 0.20}, {"cy", 0.19}, {"cz", 0.21}, {"de", 0.19}, {"dk", 0.25},
+        {"ee", 0.22}, {"es", 0.21}, {"fi", 0.255}, {"fr", 0.20}, {"gr", 0.24}, {"hr", 0.25}, {"hu", 0.27},
+        {"ie", 0.23}, {"it", 0.22}, {"lt", 0.21}, {"lu", 0.17}, {"lv", 0.21}, {"mt", 0.18}, {"nl", 0.21},
+        {"pl", 0.23}, {"pt", 0.23}, {"ro", 0.19}, {"se", 0.25}, {"si", 0.22}, {"sk", 0.23}};
+
+    template <size_t N>
+    consteval auto square_numbers()
+    {
+        std::array<uint32_t, N> keys{};
+        for (uint32_t i = 0; i < N; ++i)
+            keys[i] = i * i;
+        return PerfectHashSet<uint32_t, N>{keys};
+    }
+
+    constexpr auto vat_flat_map = make_flat_map(vat_rates);
+    constexpr auto vat_hash_map = make_perfect_hash_map(vat_rates);
+} // namespace
+
+TEST_CASE("frozen flat map & set")
+{
+    static_assert(vat_flat_map.size() == 27);
+    static_assert(vat_flat_map.at("pl") == 0.23);
+    static_assert(vat_flat_map.find("us") == nullptr);
+    static_assert(std::ranges::is_sorted(vat_flat_map.keys()));
+
+    for (const auto& [country, rate] : vat_rates)
+        REQUIRE(vat_flat_map.at(country) == rate);
+
+    CHECK_FALSE(vat_flat_map.contains(""));
+    CHECK_FALSE(vat_flat_map.contains("zz"));
+    CHECK_THROWS_AS(vat_flat_map.at("uk"), std::out_of_range);
+
+    // strings sharing the first 8 chars
+    constexpr auto units = make_flat_map<std::string_view, int>({{"frequency_hz", 1}, {"frequency_khz", 1'000}, {"frequenc", 0}, {"", -1}});
+    static_assert(units.at("frequency_khz") == 1'000);
+    static_assert(units.at("frequenc") == 0);
+    static_assert(units.at("") == -1);
+    static_assert(!units.contains("frequency") && !units.contains("frequency_mhz") && !units.contains("f"));
+
+    constexpr auto primes = make_flat_set({29, 2, 3, 5, 7, 11, 13, 17, 19, 23});
+    static_assert(primes.contains(2) && primes.contains(29));
+    static_assert(!primes.contains(1) && !primes.contains(4) && !primes.contains(30));
+
+    constexpr auto single = make_flat_set({42});
+    static_assert(single.contains(42) && !single.contains(41) && !single.contains(43));
+}
+
+TEST_CASE("frozen perfect hash map & set")
+{
+    static_assert(vat_hash_map.at("de") == 0.19);
+    static_assert(!vat_hash_map.contains("us"));
+
+    for (const auto& [country, rate] : vat_rates)
+        REQUIRE(vat_hash_map.at(country) == rate);
+
+    // every other two letter code is rejected
+    for (char a = 'a'; a <= 'z'; ++a)
+    {
+        for (char b = 'a'; b <= 'z'; ++b)
+        {
+            const std::string code{a, b};
+            REQUIRE(vat_hash_map.contains(code) == vat_flat_map.contains(code));
+        }
+    }
+
+    SECTION("enum keys")
+    {
+        constexpr auto names = make_perfect_hash_map<RatingValue, std::string_view>({
+            {RatingValue::very_poor, "very poor"},
+            {RatingValue::poor, "poor"},
+            {RatingValue::satisfactory, "satisfactory"},
+            {RatingValue::good, "good"},
+            {RatingValue::very_good, "very good"},
+            {RatingValue::excellent, "excellent"},
+        });
+
+        static_assert(names.at(RatingValue::good) == "good");
+        static_assert(!names.contains(RatingValue{0}) && !names.contains(RatingValue{7}));
+    }
+
+    SECTION("many integer keys")
+    {
+        constexpr auto squares = square_numbers<500>();
+
+        for (uint32_t i = 0; i < 500 * 500; ++i)
+        {
+            const uint32_t root = static_cast<uint32_t>(std::sqrt(i));
+            REQUIRE(squares.contains(i) == (root * root == i));
+        }
+    }
+}
+
+TEST_CASE("frozen maps - lookups vs std maps", "[.][benchmark]")
+{
+    const std::map<std::string_view, double> vat_map(std::begin(vat_rates), std::end(vat_rates));
+    const std::unordered_map<std::string_view, double> vat_unordered_map(std::begin(vat_rates), std::end(vat_rates));
+
+    // mostly hits, some misses
+    std::mt19937 rnd{42};
+    std::vector<std::string> queries(10'000);
+    for (auto& query : queries)
+        query = rnd() % 8 == 0 ? "xx"s : std::string{vat_rates[rnd() % std::size(vat_rates)].first};
+
+    auto sum_rates = [&queries](auto lookup) {
+        double sum = 0.0;
+        for (const auto& query : queries)
+            sum += lookup(query);
+        return sum;
+    };
+
+    BENCHMARK("std::map")
+    {
+        return sum_rates([&](std::string_view key) {
+            const auto it = vat_map.find(key);
+            return it != vat_map.end() ? it->second : 0.0;
+        });
+    };
+
+    BENCHMARK("std::unordered_map")
+    {
+        return sum_rates([&](std::string_view key) {
+            const auto it = vat_unordered_map.find(key);
+            return it != vat_unordered_map.end() ? it->second : 0.0;
+        });
+    };
+
+    BENCHMARK("frozen::FlatMap")
+    {
+        return sum_rates([](std::string_view key) {
+            const double* rate = vat_flat_map.find(key);
+            return rate ? *rate : 0.0;
+        });
+    };
+
+    BENCHMARK("frozen::PerfectHashMap")
+    {
+        return sum_rates([](std::string_view key) {
+            const double* rate = vat_hash_map.find(key);
+            return rate ? *rate : 0.0;
+        });
+    };
+}
@@ -0,0 +1,324 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <function.hpp>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+using namespace helpers;
+
+namespace
+{
+    std::atomic<size_t> allocation_count{0};
+
+    size_t allocations_during(auto action)
+    {
+        const size_t before = allocation_count.load();
+        action();
+        return allocation_count.load() - before;
+    }
+
+    int add(int a, int b)
+    {
+        return a + b;
+    }
+
+    struct Counter
+    {
+        int value = 0;
+
+        int next()
+        {
+            return ++value;
+        }
+    };
+} // namespace
+
+// counts heap allocations of the whole test executable (built separately from the other helpers tests)
+void* operator new(size_t size)
+{
+    ++allocation_count;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    ++allocation_count;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocation_count;
+    const auto align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    ++allocation_count;
+    const auto align = static_cast<size_t>(alignment);
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+void* operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST_CASE("inplace_function")
+{
+    static_assert(sizeof(inplace_function<int(int)>) == 64);
+
+    inplace_function<int(int, int)> f;
+    CHECK_FALSE(f);
+    CHECK_THROWS_AS(f(1, 2), std::bad_function_call);
+
+    f = add;
+    CHECK(f(1, 2) == 3);
+
+    const std::array<int64_t, 4> data{1, 2, 3, 4};
+    f = [data](int a, int b) { return a * b + static_cast<int>(std::accumulate(data.begin(), data.end(), int64_t{0})); };
+    CHECK(f(2, 3) == 16);
+
+    SECTION("copy & move")
+    {
+        auto copy = f;
+        CHECK(copy(1, 1) == 11);
+
+        auto moved = std::move(copy);
+        CHECK(moved(1, 1) == 11);
+        CHECK_FALSE(copy);
+
+        inplace_function<int(int, int), 128> bigger = std::move(moved);
+        CHECK(bigger(1, 1) == 11);
+    }
+
+    SECTION("stateful target")
+    {
+        inplace_function<int()> next = [counter = 0]() mutable { return ++counter; };
+        next();
+        CHECK(next() == 2);
+
+        auto copy = next;
+        CHECK(copy() == 3);
+        CHECK(next() == 3);
+    }
+
+    SECTION("owned state is destroyed exactly once")
+    {
+        auto resource = std::make_shared<int>(42);
+        {
+            inplace_function<int()> g = [resource] { return *resource; };
+            auto h = g;
+            auto i = std::move(h);
+            CHECK(resource.use_count() == 3);
+            i = nullptr;
+            CHECK(resource.use_count() == 2);
+        }
+        CHECK(resource.use_count() == 1);
+    }
+
+    SECTION("null function pointer gives an empty function")
+    {
+        int (*null_function)(int, int) = nullptr;
+        f = null_function;
+        CHECK_FALSE(f);
+    }
+
+    SECTION("never allocates")
+    {
+        const std::array<int64_t, 4> more_data{5, 6, 7, 8};
+        size_t result = 0;
+
+        const size_t allocations = allocations_during([&] {
+            inplace_function<size_t(), 64> g = [data, more_data] { return data.size() + more_data.size(); };
+            auto copies = std::array{g, g, g};
+            result = copies[2]();
+        });
+
+        CHECK(result == 8);
+        CHECK(allocations == 0);
+
+        CHECK(allocations_during([&] { std::function<size_t()> g = [data, more_data] { return data.size() + more_data.size(); }; }) == 1);
+    }
+}
+
+TEST_CASE("unique_function")
+{
+    unique_function<int()> f = [ptr = std::make_unique<int>(42)] { return *ptr; };
+    CHECK(f() == 42);
+
+    auto g = std::move(f);
+    CHECK(g() == 42);
+    CHECK_FALSE(f);
+
+    static_assert(!std::is_copy_constructible_v<unique_function<int()>>);
+    static_assert(std::is_nothrow_move_constructible_v<unique_function<int()>>);
+}
+
+TEST_CASE("function_ref")
+{
+    auto apply = [](function_ref<int(int, int)> f) { return f(3, 4); };
+
+    CHECK(apply(add) == 7);
+    CHECK(apply(&add) == 7);
+    CHECK(apply(std::plus<>{}) == 7);
+    CHECK(apply([offset = 10](int a, int b) { return a + b + offset; }) == 17);
+
+    Counter counter;
+    auto next_value = [&counter] { return counter.next(); };
+    function_ref<int()> next = next_value; // a temporary lambda would dangle
+    next();
+    CHECK(next() == 2);
+
+    static_assert(sizeof(function_ref<void()>) == 2 * sizeof(void*));
+}
+
+TEST_CASE("callable wrappers - allocations & call overhead", "[.][benchmark]")
+{
+    constexpr size_t count = 10'000;
+    const std::array<int64_t, 4> data{1, 2, 3, 4}; // 32 bytes - above the 16 byte buffer of std::function
+
+    auto make_creator = [&data](int64_t i) {
+        return [data, i] { return data[static_cast<size_t>(i) % data.size()] + i; };
+    };
+
+    size_t std_function_allocations = allocations_during([&] {
+        std::vector<std::function<int64_t()>> creators;
+        creators.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            creators.emplace_back(make_creator(i));
+    });
+
+    size_t inplace_function_allocations = allocations_during([&] {
+        std::vector<inplace_function<int64_t()>> creators;
+        creators.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            creators.emplace_back(make_creator(i));
+    });
+
+    std::cout << "allocations for " << count << " callables - std::function: " << std_function_allocations
+              << ", inplace_function: " << inplace_function_allocations << "\n";
+
+    BENCHMARK("construct - std::function")
+    {
+        std::vector<std::function<int64_t()>> creators;
+        creators.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            creators.emplace_back(make_creator(i));
+        return creators.size();
+    };
+
+    BENCHMARK("construct - inplace_function")
+    {
+        std::vector<inplace_function<int64_t()>> creators;
+        creators.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            creators.emplace_back(make_creator(i));
+        return creators.size();
+    };
+
+    std::vector<std::function<int64_t()>> std_functions(count, make_creator(7));
+    std::vector<inplace_function<int64_t()>> inplace_functions(count, make_creator(7));
+    std::vector<unique_function<int64_t()>> unique_functions;
+    for (size_t i = 0; i < count; ++i)
+        unique_functions.emplace_back(make_creator(7));
+
+    auto call_all = [](const auto& functions) {
+        int64_t sum = 0;
+        for (const auto& f : functions)
+            sum += f();
+        return sum;
+    };
+
+    BENCHMARK("call - std::function")
+    {
+        return call_all(std_functions);
+    };
+
+    BENCHMARK("call - inplace_function")
+    {
+        return call_all(inplace_functions);
+    };
+
+    BENCHMARK("call - unique_function")
+    {
+        return call_all(unique_functions);
+    };
+
+    const auto creator = make_creator(7);
+    const std::vector<function_ref<int64_t()>> function_refs(count, creator);
+
+    BENCHMARK("call - function_ref")
+    {
+        return call_all(function_refs);
+    };
+}
@@ -0,0 +1,120 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <helpers.hpp>
+#include <memory_resource>
+#include <vector>
+
+TEST_CASE("create_numeric_dataset - compile-time arrays")
+{
+    constexpr auto data = helpers::create_numeric_dataset<20>(42);
+
+    static_assert(data.size() == 20);
+    static_assert(std::ranges::all_of(data, [](int x) { return -100 <= x && x < 100; }));
+
+    auto runtime_data = helpers::create_numeric_dataset<20>(42, 0, 10);
+    CHECK(std::ranges::all_of(runtime_data, [](int x) { return 0 <= x && x < 10; }));
+}
+
+TEST_CASE("fill_numeric_dataset")
+{
+    constexpr size_t size = 1 << 18;
+
+    SECTION("result does not depend on number of threads")
+    {
+        std::vector<int> serial(size);
+        helpers::fill_numeric_dataset(std::span{serial}, 42, -100, 100, 1);
+
+        std::vector<int> parallel(size);
+        helpers::fill_numeric_dataset(std::span{parallel}, 42, -100, 100, 7);
+
+        CHECK(serial == parallel);
+    }
+
+    SECTION("values are taken from one PCG stream")
+    {
+        std::vector<int> data(1000);
+        helpers::fill_numeric_dataset(std::span{data}, 665, 0, 1000);
+
+        helpers::random::PCG rnd{665};
+        CHECK(std::ranges::all_of(data, [&](int x) { return x == static_cast<int>((uint64_t{rnd()} * 1000) >> 32); }));
+    }
+
+    SECTION("different seeds give different data")
+    {
+        std::vector<int> data_1(1000);
+        std::vector<int> data_2(1000);
+        helpers::fill_numeric_dataset(std::span{data_1}, 1);
+        helpers::fill_numeric_dataset(std::span{data_2}, 2);
+
+        CHECK(data_1 != data_2);
+    }
+
+    SECTION("other element types")
+    {
+        std::vector<int64_t> big_ints(size);
+        helpers::fill_numeric_dataset(std::span{big_ints}, 42, -10'000'000'000, 10'000'000'000);
+        CHECK(std::ranges::all_of(big_ints, [](int64_t x) { return -10'000'000'000 <= x && x < 10'000'000'000; }));
+        CHECK(std::ranges::any_of(big_ints, [](int64_t x) { return x > std::numeric_limits<int32_t>::max(); }));
+
+        std::vector<float> floats(size);
+        helpers::fill_numeric_dataset(std::span{floats}, 42, -1.0f, 1.0f);
+        CHECK(std::ranges::all_of(floats, [](float x) { return -1.0f <= x && x < 1.0f; }));
+
+        std::vector<double> doubles(size);
+        helpers::fill_numeric_dataset(std::span{doubles}, 42, 0.0, 1.0);
+        CHECK(std::ranges::all_of(doubles, [](double x) { return 0.0 <= x && x < 1.0; }));
+
+        CHECK(helpers::details::map_to_range(~uint64_t{0}, 0.0, 1.0) < 1.0);
+        CHECK(helpers::details::map_to_range(uint64_t{~uint32_t{0}}, 0.0f, 1.0f) < 1.0f);
+        static_assert(!helpers::NumericDatasetElement<long double>);
+    }
+}
+
+TEST_CASE("create_numeric_dataset - runtime size")
+{
+    SECTION("allocates with given memory resource")
+    {
+        std::pmr::monotonic_buffer_resource pool{1 << 20};
+
+        auto data = helpers::create_numeric_dataset<double>(10'000, 42, -1.0, 1.0, &pool);
+
+        CHECK(data.size() == 10'000);
+        CHECK(data.get_allocator().resource() == &pool);
+    }
+
+    SECTION("same as filling a span")
+    {
+        auto data = helpers::create_numeric_dataset(100'000, 42);
+
+        std::vector<int> expected(100'000);
+        helpers::fill_numeric_dataset(std::span{expected}, 42);
+
+        CHECK(std::ranges::equal(data, expected));
+    }
+}
+
+TEST_CASE("create_numeric_dataset - serial vs parallel", "[.][benchmark]")
+{
+    std::vector<int> data(10'000'000);
+
+    BENCHMARK("std::mt19937 - serial")
+    {
+        std::mt19937 rnd{42};
+        std::ranges::generate(data, [&] { return static_cast<int>(rnd() % 200u) - 100; });
+        return data.back();
+    };
+
+    BENCHMARK("fill_numeric_dataset - 1 thread")
+    {
+        helpers::fill_numeric_dataset(std::span{data}, 42, -100, 100, 1);
+        return data.back();
+    };
+
+    BENCHMARK("fill_numeric_dataset - all threads")
+    {
+        helpers::fill_numeric_dataset(std::span{data}, 42);
+        return data.back();
+    };
+}
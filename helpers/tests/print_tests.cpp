@@ -0,0 +1,158 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <helpers.hpp>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    // implementation of helpers::print before buffering - defines the expected format
+    void print_with_ostream(std::ostream& out, helpers::PrintableRange auto&& rng, std::string_view prefix = "rng")
+    {
+        out << prefix << " = [ ";
+        for (const auto& item : rng)
+        {
+            if constexpr (std::convertible_to<decltype(item), std::string_view>)
+            {
+                out << '"' << item << '"' << " ";
+            }
+            else
+            {
+                out << item << " ";
+            }
+        }
+        out << "]\n";
+    }
+
+    std::string expected_output(helpers::PrintableRange auto&& rng, std::string_view prefix = "rng")
+    {
+        std::ostringstream out;
+        print_with_ostream(out, rng, prefix);
+        return out.str();
+    }
+
+    std::string captured_output(helpers::PrintableRange auto&& rng, std::string_view prefix = "rng", helpers::PrintOptions options = {})
+    {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+
+        options.fd = fileno(file);
+        helpers::print(rng, prefix, options);
+
+        std::string result(static_cast<size_t>(std::ftell(file)), '\0');
+        std::rewind(file);
+        result.resize(std::fread(result.data(), 1, result.size(), file));
+        std::fclose(file);
+
+        return result;
+    }
+
+    struct Point
+    {
+        int x, y;
+
+        friend std::ostream& operator<<(std::ostream& out, const Point& pt)
+        {
+            return out << "Point(" << pt.x << ", " << pt.y << ")";
+        }
+    };
+} // namespace
+
+TEST_CASE("print - keeps output format")
+{
+    SECTION("numbers")
+    {
+        std::vector<int> ints = {1, -2, 3, 42};
+        CHECK(captured_output(ints, "ints") == expected_output(ints, "ints"));
+
+        std::vector<double> doubles = {3.14159265, -0.5, 1e20, 1.0 / 3.0, 100.0};
+        CHECK(captured_output(doubles) == expected_output(doubles));
+
+        std::vector<unsigned long long> big = {0, 18'446'744'073'709'551'615ULL};
+        CHECK(captured_output(big) == expected_output(big));
+    }
+
+    SECTION("strings are quoted")
+    {
+        std::vector words = {"one"s, "two"s};
+        CHECK(captured_output(words, "words") == "words = [ \"one\" \"two\" ]\n");
+
+        std::vector<const char*> c_words = {"one", "two"};
+        CHECK(captured_output(c_words) == expected_output(c_words));
+    }
+
+    SECTION("chars and bools")
+    {
+        std::vector chars = {'a', 'b'};
+        CHECK(captured_output(chars) == expected_output(chars));
+
+        std::vector bools = {true, false};
+        CHECK(captured_output(bools) == expected_output(bools));
+    }
+
+    SECTION("types with operator<<")
+    {
+        std::vector points = {Point{1, 2}, Point{3, 4}};
+        CHECK(captured_output(points, "points") == "points = [ Point(1, 2) Point(3, 4) ]\n");
+    }
+
+    SECTION("views")
+    {
+        std::map<int, std::string> dict = {{1, "one"}, {2, "two"}};
+        CHECK(captured_output(dict | std::views::values, "values") == expected_output(dict | std::views::values, "values"));
+    }
+
+    SECTION("empty range")
+    {
+        CHECK(captured_output(std::vector<int>{}) == "rng = [ ]\n");
+    }
+}
+
+TEST_CASE("print - options")
+{
+    std::vector<int> data(100'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    SECTION("max_items truncates output")
+    {
+        CHECK(captured_output(data, "data", {.max_items = 3}) == "data = [ 0 1 2 ... ]\n");
+    }
+
+    SECTION("max_items equal to size does not truncate")
+    {
+        CHECK(captured_output(std::vector{1, 2}, "data", {.max_items = 2}) == "data = [ 1 2 ]\n");
+    }
+
+    SECTION("large ranges are flushed in chunks")
+    {
+        CHECK(captured_output(data, "data", {.flush_threshold = 1024}) == expected_output(data, "data"));
+    }
+}
+
+TEST_CASE("print - buffered vs std::ostream", "[.][benchmark]")
+{
+    std::vector<int> data(1'000'000);
+    std::iota(data.begin(), data.end(), -500'000);
+
+    std::ofstream dev_null_stream{"/dev/null"};
+    std::FILE* dev_null = std::fopen("/dev/null", "w");
+
+    BENCHMARK("std::ostream - operator<< per item")
+    {
+        print_with_ostream(dev_null_stream, data, "data");
+    };
+
+    BENCHMARK("helpers::print - buffered")
+    {
+        helpers::print(data, "data", {.fd = fileno(dev_null)});
+    };
+
+    std::fclose(dev_null);
+}
@@ -0,0 +1,219 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <random.hpp>
+#include <ranges>
+#include <span>
+#include <vector>
+
+using helpers::random::PCG;
+using helpers::random::PCGLanes;
+
+namespace
+{
+    std::vector<uint32_t> scalar_stream(uint64_t seed, size_t size)
+    {
+        PCG rnd{seed};
+        std::vector<uint32_t> values(size);
+        std::ranges::generate(values, rnd);
+        return values;
+    }
+
+    template <size_t Lanes>
+    std::vector<uint32_t> batch_stream(uint64_t seed, size_t size)
+    {
+        PCG rnd{seed};
+        std::vector<uint32_t> values(size);
+        rnd.fill<Lanes>(values);
+        return values;
+    }
+
+    template <size_t N>
+    constexpr std::array<uint32_t, N> batch_at_compile_time(uint64_t seed)
+    {
+        PCG rnd{seed};
+        std::array<uint32_t, N> values{};
+        rnd.fill<16>(values);
+        return values;
+    }
+} // namespace
+
+TEST_CASE("PCG - batch fill")
+{
+    SECTION("is bit-identical with scalar stream for every lane layout")
+    {
+        for (size_t size : {0, 1, 3, 4, 15, 16, 17, 1'000, 1'027})
+        {
+            const auto expected = scalar_stream(42, size);
+
+            CHECK(batch_stream<4>(42, size) == expected);
+            CHECK(batch_stream<8>(42, size) == expected);
+            CHECK(batch_stream<16>(42, size) == expected);
+        }
+    }
+
+    SECTION("continues the scalar stream")
+    {
+        PCG rnd{665};
+        std::vector<uint32_t> values(37);
+        rnd.fill(values);
+
+        std::vector<uint32_t> rest(5);
+        std::ranges::generate(rest, rnd);
+
+        values.insert(values.end(), rest.begin(), rest.end());
+        CHECK(values == scalar_stream(665, 42));
+    }
+
+    SECTION("lanes fill only whole rounds")
+    {
+        PCGLanes<8> lanes{PCG{42}};
+        std::vector<uint32_t> values(20);
+
+        REQUIRE(lanes.fill(values) == 16);
+        CHECK(std::ranges::equal(values | std::views::take(16), scalar_stream(42, 16)));
+    }
+
+    SECTION("works in constant evaluation")
+    {
+        constexpr auto values = batch_at_compile_time<21>(42);
+        constexpr auto expected = [] {
+            PCG rnd{42};
+            std::array<uint32_t, 21> values{};
+            std::ranges::generate(values, rnd);
+            return values;
+        }();
+
+        static_assert(values == expected);
+    }
+}
+
+TEST_CASE("PCG - jump-ahead")
+{
+    SECTION("advance(n) is equivalent to n calls")
+    {
+        PCG stepped{42};
+        for (int i = 0; i < 1'000; ++i)
+            stepped();
+
+        PCG jumped{42};
+        jumped.advance(1'000);
+
+        CHECK(jumped() == stepped());
+    }
+
+    SECTION("advance with negative delta goes back")
+    {
+        PCG rnd{42};
+        const auto first = rnd();
+        rnd.advance(-1);
+
+        CHECK(rnd() == first);
+    }
+
+    SECTION("chunks generated independently form the serial sequence")
+    {
+        constexpr size_t chunk_size = 1'000;
+        constexpr size_t chunks = 8;
+
+        std::vector<uint32_t> values(chunk_size * chunks);
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk) // each chunk could be filled by another thread
+        {
+            PCG rnd{42};
+            rnd.advance(chunk * chunk_size);
+            rnd.fill(std::span{values}.subspan(chunk * chunk_size, chunk_size));
+        }
+
+        CHECK(values == scalar_stream(42, chunk_size * chunks));
+    }
+
+    SECTION("works in constant evaluation")
+    {
+        constexpr auto value = [] {
+            PCG rnd{42};
+            rnd.advance(100);
+            return rnd();
+        }();
+
+        PCG rnd{42};
+        rnd.advance(100);
+        CHECK(rnd() == value);
+    }
+}
+
+TEST_CASE("PCG - streams")
+{
+    PCG rnd{42};
+
+    SECTION("stream 0 is the default stream")
+    {
+        CHECK(rnd.split(0).rng.inc == rnd.rng.inc);
+    }
+
+    SECTION("different streams produce different sequences")
+    {
+        auto stream_1 = rnd.split(1);
+        auto stream_2 = rnd.split(2);
+
+        std::vector<uint32_t> values_1(100);
+        std::vector<uint32_t> values_2(100);
+        stream_1.fill(values_1);
+        stream_2.fill(values_2);
+
+        CHECK(values_1 != values_2);
+        CHECK(values_1 != scalar_stream(42, 100));
+    }
+
+    SECTION("stream ids are 63-bit")
+    {
+        CHECK(rnd.split(uint64_t{1} << 62).rng.inc != rnd.split(0).rng.inc);
+        CHECK(rnd.split((uint64_t{1} << 63) + 5).rng.inc == rnd.split(5).rng.inc);
+    }
+
+    SECTION("streams can be jumped ahead")
+    {
+        auto stream = rnd.split(7);
+        auto jumped = stream;
+
+        for (int i = 0; i < 10; ++i)
+            stream();
+        jumped.advance(10);
+
+        CHECK(jumped() == stream());
+    }
+}
+
+TEST_CASE("PCG - batch fill vs scalar generation", "[.][benchmark]")
+{
+    std::vector<uint32_t> values(1'000'000);
+
+    BENCHMARK("scalar operator()")
+    {
+        PCG rnd{42};
+        std::ranges::generate(values, rnd);
+        return values.back();
+    };
+
+    BENCHMARK("fill - 4 lanes")
+    {
+        PCG rnd{42};
+        rnd.fill<4>(values);
+        return values.back();
+    };
+
+    BENCHMARK("fill - 8 lanes")
+    {
+        PCG rnd{42};
+        rnd.fill<8>(values);
+        return values.back();
+    };
+
+    BENCHMARK("fill - 16 lanes")
+    {
+        PCG rnd{42};
+        rnd.fill<16>(values);
+        return values.back();
+    };
+}
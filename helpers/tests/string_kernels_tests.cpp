@@ -0,0 +1,228 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_kernels.hpp>
+#include <vector>
+
+using namespace std::literals;
+using namespace helpers::strings;
+
+namespace
+{
+    // every char (including non-ASCII bytes) at every position of texts shorter and longer than a register
+    std::vector<std::string> sample_texts()
+    {
+        std::mt19937 rnd{42};
+        const std::string alphabet = "abcXYZ019 \t\n\v\f\r/,;-_\x80\xC3\xFF"s;
+
+        std::vector<std::string> texts;
+        for (size_t length : {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000})
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                std::string text(length, ' ');
+                for (char& c : text)
+                    c = alphabet[rnd() % alphabet.size()];
+                texts.push_back(text);
+            }
+        }
+
+        return texts;
+    }
+
+    std::pair<std::string_view, std::string_view> split_with_find(std::string_view line, std::string_view separator = "/")
+    {
+        std::pair<std::string_view, std::string_view> result;
+
+        if (std::string::size_type pos = line.find(separator.data()); pos != std::string::npos)
+        {
+            result.first = std::string_view{line.begin(), line.begin() + pos};
+            result.second = std::string_view{line.begin() + pos + 1, line.end()};
+        }
+
+        return result;
+    }
+} // namespace
+
+TEST_CASE("string kernels - length")
+{
+    static_assert(length("") == 0);
+    static_assert(length("Hello") == 5);
+
+    // every alignment of the start and the terminator
+    std::string buffer(200, 'x');
+    for (size_t start = 0; start < 64; ++start)
+    {
+        for (size_t size : {0, 1, 15, 16, 31, 32, 33, 100})
+        {
+            std::string text = buffer;
+            text[start + size] = '\0';
+            REQUIRE(length(text.c_str() + start) == size);
+        }
+    }
+}
+
+TEST_CASE("string kernels - search")
+{
+    static_assert(find("a/b", '/') == 1);
+    static_assert(find_any("key=value;next", "=;") == 3);
+    static_assert(find_whitespace("abc def") == 3);
+    static_assert(find_non_whitespace(" \t\nabc") == 3);
+    static_assert(trim("  text\n") == "text");
+
+    for (const auto& text : sample_texts())
+    {
+        const std::string_view view = text;
+
+        for (size_t pos : {0, 1, 20})
+        {
+            REQUIRE(find(view, '/', pos) == view.find('/', pos));
+            REQUIRE(find(view, '\xC3', pos) == view.find('\xC3', pos));
+            REQUIRE(find_any(view, ",;", pos) == view.find_first_of(",;", pos));
+            REQUIRE(find_any(view, "/,;-_XYZ", pos) == view.find_first_of("/,;-_XYZ", pos));
+            REQUIRE(find_any(view, "/,;-_XYZ019", pos) == view.find_first_of("/,;-_XYZ019", pos));
+            REQUIRE(find_whitespace(view, pos) == view.find_first_of(" \t\n\v\f\r", pos));
+            REQUIRE(find_non_whitespace(view, pos) == view.find_first_not_of(" \t\n\v\f\r", pos));
+        }
+    }
+
+    CHECK(find_any("abc", "") == npos);
+    CHECK(trim(" \t ") == "");
+}
+
+TEST_CASE("string kernels - split")
+{
+    CHECK(split_once("324/44", '/') == std::pair{"324"sv, "44"sv});
+    CHECK(split_once("4343", '/') == std::pair{""sv, ""sv});
+    CHECK(split_once("345/", '/') == std::pair{"345"sv, ""sv});
+    CHECK(split_once("/434", '/') == std::pair{""sv, "434"sv});
+
+    std::vector<std::string_view> tokens;
+    split("a,b;;c,", ",;", [&tokens](std::string_view token) { tokens.push_back(token); });
+    CHECK(tokens == std::vector{"a"sv, "b"sv, ""sv, "c"sv, ""sv});
+
+    constexpr size_t token_count = [] {
+        size_t count = 0;
+        split("1 2 3 4", " ", [&count](std::string_view) { ++count; });
+        return count;
+    }();
+    static_assert(token_count == 4);
+}
+
+TEST_CASE("string kernels - case conversion")
+{
+    static_assert(to_upper_copy("Hello World!") == "HELLO WORLD!");
+    static_assert(to_lower_copy("Hello World!") == "hello world!");
+
+    for (const auto& text : sample_texts())
+    {
+        std::string expected_upper = text;
+        std::string expected_lower = text;
+        for (char& c : expected_upper)
+            c = ('a' <= c && c <= 'z') ? static_cast<char>(c - 32) : c;
+        for (char& c : expected_lower)
+            c = ('A' <= c && c <= 'Z') ? static_cast<char>(c + 32) : c;
+
+        REQUIRE(to_upper_copy(text) == expected_upper);
+        REQUIRE(to_lower_copy(text) == expected_lower);
+    }
+
+    // all 256 byte values - only ASCII letters change
+    std::string all_bytes(256, '\0');
+    for (int i = 0; i < 256; ++i)
+        all_bytes[i] = static_cast<char>(i);
+
+    const std::string upper = to_upper_copy(all_bytes);
+    for (int i = 0; i < 256; ++i)
+        REQUIRE(static_cast<unsigned char>(upper[i]) == ('a' <= i && i <= 'z' ? i - 32 : i));
+}
+
+TEST_CASE("string kernels - vs current code", "[.][benchmark]")
+{
+    std::mt19937 rnd{665};
+    std::string text(1 << 20, 'a');
+    for (char& c : text)
+        c = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 "[rnd() % 63];
+    text.back() = '/';
+
+    std::vector<std::string> lines(10'000);
+    for (auto& line : lines)
+        line = std::to_string(rnd()) + std::string(rnd() % 64, 'x') + "/" + std::to_string(rnd());
+
+    BENCHMARK("length - strlen")
+    {
+        return std::strlen(text.c_str());
+    };
+
+    BENCHMARK("length - helpers::strings::length")
+    {
+        return length(text.c_str());
+    };
+
+    BENCHMARK("find - string_view::find")
+    {
+        return std::string_view{text}.find('/');
+    };
+
+    BENCHMARK("find - helpers::strings::find")
+    {
+        return find(text, '/');
+    };
+
+    BENCHMARK("find_any - string_view::find_first_of")
+    {
+        return std::string_view{text}.find_first_of("/;,");
+    };
+
+    BENCHMARK("find_any - helpers::strings::find_any")
+    {
+        return find_any(text, "/;,");
+    };
+
+    BENCHMARK("split lines - string_view::find")
+    {
+        size_t total = 0;
+        for (const auto& line : lines)
+            total += split_with_find(line).second.size();
+        return total;
+    };
+
+    BENCHMARK("split lines - helpers::strings::split_once")
+    {
+        size_t total = 0;
+        for (const auto& line : lines)
+            total += split_once(line, '/').second.size();
+        return total;
+    };
+
+    BENCHMARK("to upper - std::toupper")
+    {
+        std::string result = text;
+        std::transform(result.begin(), result.end(), result.begin(), [](auto c) { return std::toupper(c); });
+        return result.back();
+    };
+
+    BENCHMARK("to upper - helpers::strings::to_upper")
+    {
+        std::string result = text;
+        to_upper(result);
+        return result.back();
+    };
+
+    BENCHMARK("whitespace - std::isspace")
+    {
+        return std::ranges::count_if(text, [](unsigned char c) { return std::isspace(c); });
+    };
+
+    BENCHMARK("whitespace - helpers::strings::find_whitespace")
+    {
+        size_t count = 0;
+        for (size_t pos = find_whitespace(text); pos != npos; pos = find_whitespace(text, pos + 1))
+            ++count;
+        return count;
+    };
+}
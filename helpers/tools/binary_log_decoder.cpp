@@ -0,0 +1,40 @@
+#include <binary_log.hpp>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+// binary_log_decoder [file] - decodes a binary log (binary_log.hpp) from the file or from stdin
+int main(int argc, char* argv[])
+{
+    if (argc > 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [binary log file]\n";
+        return 1;
+    }
+
+    std::ifstream file;
+    if (argc == 2)
+    {
+        file.open(argv[1], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "cannot open " << argv[1] << "\n";
+            return 1;
+        }
+    }
+
+    std::istream& in = argc == 2 ? file : std::cin;
+    const std::string log{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    try
+    {
+        helpers::log::decode_binary_log(log, std::cout);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
@@ -1,13 +1,13 @@
 module;
 
-#include <functional>
+#include <function.hpp> // non-allocating callable wrappers from helpers
 #include <memory>
 #include <string>
 #include <unordered_map>
 
 export module Factory;
 
-export template <typename TProduct, typename TId = std::string, typename TCreator = std::function<std::unique_ptr<TProduct>()>>
+export template <typename TProduct, typename TId = std::string, typename TCreator = helpers::inplace_function<std::unique_ptr<TProduct>()>>
 class GenericFactory
 {
     std::unordered_map<TId, TCreator> creators_;
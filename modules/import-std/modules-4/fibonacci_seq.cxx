@@ -4,28 +4,89 @@ import std;
 
 export namespace Math::Fibonacci // all declarations in this namespace are exported
 {
-    constexpr std::uint32_t fibonacci(std::uint32_t n)
+    // unsigned types at least as wide as unsigned int - narrower ones would be promoted to (signed) int
+    template <typename T>
+    concept FibonacciInteger = (std::unsigned_integral<T> && !std::same_as<T, bool> && sizeof(T) >= sizeof(unsigned))
+#ifdef __SIZEOF_INT128__
+        || std::same_as<T, unsigned __int128>
+#endif
+        ;
+
+    // largest n for which F(n) fits in T
+    template <FibonacciInteger T>
+    constexpr std::uint32_t fibonacci_max_index = [] {
+        const T max = static_cast<T>(~T{0});
+
+        T previous = 0;
+        T current = 1;
+        std::uint32_t n = 1;
+        while (current <= max - previous)
+        {
+            const T next = previous + current;
+            previous = current;
+            current = next;
+            ++n;
+        }
+
+        return n;
+    }();
+
+    // fast doubling - F(2k) = F(k) * (2 * F(k + 1) - F(k)), F(2k + 1) = F(k)^2 + F(k + 1)^2;
+    // O(log n) steps, the result is F(n) modulo 2^bits of T
+    template <FibonacciInteger T>
+    constexpr T fibonacci_fast(std::uint64_t n)
     {
-        if (n <= 1)
+        T a = 0; // F(k) for k = the leading bits of n processed so far
+        T b = 1; // F(k + 1)
+
+        for (int bit = std::bit_width(n) - 1; bit >= 0; --bit)
         {
-            return n;
+            const T f_2k = a * (2 * b - a);
+            const T f_2k_1 = a * a + b * b;
+
+            if ((n >> bit) & 1)
+            {
+                a = f_2k_1;
+                b = f_2k + f_2k_1;
+            }
+            else
+            {
+                a = f_2k;
+                b = f_2k_1;
+            }
         }
 
-        return fibonacci(n - 1) + fibonacci(n - 2);
+        return a;
+    }
+
+    // F(n) or std::nullopt if it does not fit in T
+    template <FibonacciInteger T>
+    constexpr std::optional<T> fibonacci_checked(std::uint64_t n)
+    {
+        if (n > fibonacci_max_index<T>)
+            return std::nullopt;
+
+        return fibonacci_fast<T>(n);
+    }
+
+    constexpr std::uint32_t fibonacci(std::uint32_t n)
+    {
+        return fibonacci_fast<std::uint32_t>(n);
     }
 
-    template <std::uint32_t N>
-    constexpr std::array<std::uint32_t, N> get_fibonacci_sequence()
+    // F(0), ..., F(N - 1) - every value is the sum of the two previous ones
+    template <std::uint32_t N, FibonacciInteger T = std::uint32_t>
+    constexpr std::array<T, N> get_fibonacci_sequence()
     {
-        std::array<std::uint32_t, N> fibonaccis{};
+        std::array<T, N> fibonaccis{};
 
         for (std::uint32_t i = 0; i < N; ++i)
         {
-            fibonaccis[i] = fibonacci(i);
+            fibonaccis[i] = i <= 1 ? i : fibonaccis[i - 1] + fibonaccis[i - 2];
         }
 
         return fibonaccis;
     }
 
     constexpr std::array fibonacci_lookup_table = get_fibonacci_sequence<20>();
-}
\ No newline at end of file
+}
@@ -6,6 +6,8 @@ module; // global fragment module
 #include <limits>
 #include <ranges>
 #include <algorithm>
+#include <bit>
+#include <vector>
 
 export module Primes; // declaration of module Primes - primary module interface
 
@@ -31,16 +33,85 @@ struct IsPrime
     }
 };
 
-export template <uint32_t N>
-constexpr std::array<uint32_t, N> get_primes()
+// upper bound of the n-th prime without floating point: p(n) < n * (ln n + ln ln n) for n >= 6 (Rosser),
+// ln x is over-estimated as 0.7 * bit_width(x)
+constexpr uint64_t nth_prime_upper_bound(uint64_t n)
 {
+    if (n < 6)
+        return 13;
+
+    auto ln_upper = [](uint64_t x) -> uint64_t { return std::bit_width(x) * 7 / 10 + 1; };
+
+    return n * (ln_upper(n) + ln_upper(ln_upper(n)));
+}
+
+// sieve of Eratosthenes over odd numbers processed in segments - near-linear work; one byte per odd number
+// keeps constant evaluation cheap (no bit arithmetic per crossed out multiple); GCC's default
+// -fconstexpr-ops-limit (2^25) suffices for N up to about 60'000 - larger tables need a raised
+// limit (-fconstexpr-ops-limit, clang: -fconstexpr-steps)
+template <uint32_t N>
+constexpr std::array<uint32_t, N> sieve_primes()
+{
+    static_assert(N <= 203'280'221, "primes must fit in uint32_t - there are 203'280'221 primes below 2^32");
+
     std::array<uint32_t, N> primes{};
+    if (N == 0)
+        return primes;
+
+    primes[0] = 2;
+    size_t count = 1;
+
+    constexpr uint32_t segment_size = 1 << 15;
+    const uint64_t limit = nth_prime_upper_bound(N);
+    const uint64_t odd_count = limit / 2; // index i represents odd number 2 * i + 1
+
+    std::vector<uint64_t> base_primes;   // primes p with p * p < limit
+    std::vector<uint64_t> next_multiple; // index of the next odd multiple to cross out
+    bool composite[segment_size] = {};
 
-    auto primes_view = std::views::iota(2u) | std::views::filter(is_prime) | std::views::take(N);
+    for (uint64_t low = 0; low < odd_count && count < N; low += segment_size)
+    {
+        const uint64_t size = std::min<uint64_t>(segment_size, odd_count - low);
+        std::fill(composite, composite + size, false);
+        if (low == 0)
+            composite[0] = true; // 1 is not a prime
+
+        for (size_t j = 0; j < base_primes.size(); ++j)
+        {
+            const uint64_t step = base_primes[j]; // odd multiples of p are 2p apart
+            uint64_t i = next_multiple[j] - low;
+            for (; i < size; i += step)
+                composite[i] = true;
+            next_multiple[j] = low + i;
+        }
+
+        for (uint64_t i = 0; i < size && count < N; ++i)
+        {
+            if (composite[i])
+                continue;
 
-    std::ranges::copy(primes_view, primes.begin());
+            const uint64_t p = 2 * (low + i) + 1;
+            primes[count++] = static_cast<uint32_t>(p);
+
+            if (p * p < limit)
+            {
+                uint64_t multiple = p * p / 2 - low;
+                for (; multiple < size; multiple += p)
+                    composite[multiple] = true;
+
+                base_primes.push_back(p);
+                next_multiple.push_back(low + multiple);
+            }
+        }
+    }
 
     return primes;
 }
 
+export template <uint32_t N>
+constexpr std::array<uint32_t, N> get_primes()
+{
+    return sieve_primes<N>();
+}
+
 export constexpr std::array first_primes = get_primes<100>();
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+import Primes; // importing module Primes
+
+namespace
+{
+    // baseline - one vector of primes behind a mutex, regrown with get_primes_vec when too short
+    class LockedPrimeCache
+    {
+    public:
+        uint64_t nth_prime(uint64_t k)
+        {
+            std::lock_guard lock{mtx_};
+            if (primes_.size() < k)
+                primes_ = get_primes_vec(static_cast<uint32_t>(std::max<uint64_t>(k, 2 * primes_.size())));
+            return primes_[k - 1];
+        }
+
+    private:
+        std::mutex mtx_;
+        std::vector<uint32_t> primes_;
+    };
+
+    constexpr uint64_t max_k = 5'000'000;
+    constexpr size_t queries_per_thread = 200'000;
+
+    // all threads start together and query random ranks; returns queries per microsecond
+    template <typename Cache>
+    double run_readers(Cache& cache, unsigned thread_count)
+    {
+        std::vector<uint64_t> checksums(thread_count);
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> threads;
+            for (unsigned t = 0; t < thread_count; ++t)
+            {
+                threads.emplace_back([&, t] {
+                    std::mt19937_64 rnd{t};
+                    for (size_t i = 0; i < queries_per_thread; ++i)
+                        checksums[t] += cache.nth_prime(rnd() % max_k + 1);
+                });
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+        return thread_count * queries_per_thread / elapsed.count();
+    }
+} // namespace
+
+int main()
+{
+    std::cout << "nth_prime(k), k <= " << max_k << " - queries per microsecond\n";
+    std::cout << "threads | PrimeCache cold | PrimeCache warm | mutex + vector\n";
+
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+    {
+        PrimeCache cold_cache; // extended on demand while the readers run
+        const double cold = run_readers(cold_cache, threads);
+
+        PrimeCache warm_cache;
+        warm_cache.nth_prime(max_k);
+        const double warm = run_readers(warm_cache, threads);
+
+        LockedPrimeCache locked_cache;
+        const double locked = run_readers(locked_cache, threads);
+
+        std::cout << threads << " | " << cold << " | " << warm << " | " << locked << "\n";
+    }
+}
@@ -1,8 +1,15 @@
 module; // global fragment module
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 #include <vector>
-#include <ranges>
 
 module Primes; // module implementation unit
 
@@ -20,11 +27,612 @@ bool IsPrime::operator()(uint32_t n) const
     return true;
 }
 
+namespace
+{
+    constexpr uint64_t max_limit = uint64_t{1} << 32;
+
+    // segment fits in L1 cache: one bit per odd number
+    constexpr size_t segment_words = 32 * 1024 / sizeof(uint64_t);
+    constexpr uint64_t segment_span = segment_words * 64 * 2;
+
+    // odd primes p <= n - simple sieve for the base primes of the segmented sieve
+    std::vector<uint32_t> odd_primes_up_to(uint32_t n)
+    {
+        std::vector<bool> composite(n / 2 + 1);
+        std::vector<uint32_t> primes;
+
+        for (uint32_t i = 3; i <= n; i += 2)
+        {
+            if (composite[i / 2])
+                continue;
+
+            primes.push_back(i);
+            for (uint64_t multiple = uint64_t{i} * i; multiple <= n; multiple += 2 * i)
+                composite[multiple / 2] = true;
+        }
+
+        return primes;
+    }
+
+    // upper bound of the n-th prime: p(n) < n * (ln n + ln ln n) for n >= 6 (Rosser)
+    uint64_t nth_prime_upper_bound(uint32_t n)
+    {
+        if (n < 6)
+            return 13;
+
+        const double log_n = std::log(static_cast<double>(n));
+        return std::min(max_limit, static_cast<uint64_t>(n * (log_n + std::log(log_n))) + 1);
+    }
+
+    // approximation of pi(x) used only to reserve memory
+    size_t prime_count_estimate(uint64_t limit)
+    {
+        if (limit < 100)
+            return 25;
+
+        const double x = static_cast<double>(limit);
+        return static_cast<size_t>(1.26 * x / std::log(x));
+    }
+
+    // segmented sieve of Eratosthenes over odd numbers; stops after max_count primes
+    std::vector<uint32_t> sieve_primes(uint64_t limit, size_t max_count)
+    {
+        limit = std::min(limit, max_limit);
+
+        std::vector<uint32_t> primes;
+        if (limit <= 2 || max_count == 0)
+            return primes;
+
+        primes.reserve(std::min(max_count, prime_count_estimate(limit)));
+        primes.push_back(2);
+        if (primes.size() == max_count)
+            return primes;
+
+        const auto base_primes = odd_primes_up_to(static_cast<uint32_t>(std::sqrt(static_cast<double>(limit - 1))) + 1);
+
+        std::vector<uint64_t> next_multiple(base_primes.size());
+        std::ranges::transform(base_primes, next_multiple.begin(), [](uint64_t p) { return p * p; });
+
+        std::vector<uint64_t> composite(segment_words); // bit i of segment starting at low represents low + 2 * i
+
+        for (uint64_t low = 1; low < limit; low += segment_span)
+        {
+            const uint64_t high = std::min(low + segment_span, limit);
+
+            std::ranges::fill(composite, 0);
+
+            for (size_t i = 0; i < base_primes.size() && uint64_t{base_primes[i]} * base_primes[i] < high; ++i)
+            {
+                // no multiple in this segment - later primes may still have one
+                if (next_multiple[i] >= high)
+                    continue;
+
+                const uint64_t step = 2 * uint64_t{base_primes[i]};
+                uint64_t multiple = next_multiple[i];
+
+                for (; multiple < high; multiple += step)
+                {
+                    const uint64_t bit = (multiple - low) / 2;
+                    composite[bit / 64] |= uint64_t{1} << (bit % 64);
+                }
+
+                next_multiple[i] = multiple;
+            }
+
+            const uint64_t bits = (high - low + 1) / 2;
+
+            for (uint64_t word = 0; word * 64 < bits; ++word)
+            {
+                uint64_t candidates = ~composite[word];
+                if (bits - word * 64 < 64)
+                    candidates &= (uint64_t{1} << (bits - word * 64)) - 1;
+
+                while (candidates != 0)
+                {
+                    const uint64_t n = low + 2 * (word * 64 + std::countr_zero(candidates));
+                    candidates &= candidates - 1;
+
+                    if (n == 1)
+                        continue;
+
+                    primes.push_back(static_cast<uint32_t>(n));
+                    if (primes.size() == max_count)
+                        return primes;
+                }
+            }
+        }
+
+        return primes;
+    }
+
+    // mod-30 wheel: residues coprime to 30, gap to the next one and bit of every residue (0 if not coprime)
+    constexpr std::array<uint8_t, 8> wheel_residues = {1, 7, 11, 13, 17, 19, 23, 29};
+    constexpr std::array<uint8_t, 8> wheel_gaps = {6, 4, 2, 4, 2, 4, 6, 2};
+
+    constexpr auto wheel_bits = [] {
+        std::array<uint8_t, 30> bits{};
+        for (size_t i = 0; i < wheel_residues.size(); ++i)
+            bits[wheel_residues[i]] = uint8_t(1u << i);
+        return bits;
+    }();
+
+    constexpr auto wheel_index = [] {
+        std::array<uint8_t, 30> index{};
+        for (size_t i = 0; i < wheel_residues.size(); ++i)
+            index[wheel_residues[i]] = uint8_t(i);
+        return index;
+    }();
+
+    // bits of residues r' <= r
+    constexpr auto wheel_bits_up_to = [] {
+        std::array<uint8_t, 30> masks{};
+        uint8_t mask = 0;
+        for (size_t r = 0; r < 30; ++r)
+            masks[r] = mask |= wheel_bits[r];
+        return masks;
+    }();
+
+    // byte k of the bitmap has bit i set if 30k + wheel_residues[i] is a prime below limit
+    std::vector<uint8_t> sieve_wheel_bytes(uint64_t limit)
+    {
+        const uint64_t byte_count = (limit + 29) / 30;
+        std::vector<uint8_t> bytes((byte_count + 7) / 8 * 8); // padded to whole 64-bit words
+        if (limit <= 7)
+            return bytes;
+
+        const auto base_primes = odd_primes_up_to(static_cast<uint32_t>(std::sqrt(static_cast<double>(limit - 1))) + 1);
+
+        struct Crossing
+        {
+            uint64_t multiple; // next multiple p * q with q coprime to 30
+            uint64_t p;
+            uint8_t q_index;   // wheel index of q
+        };
+
+        std::vector<Crossing> crossings;
+        for (uint64_t p : base_primes)
+        {
+            if (p > 5)
+                crossings.push_back({p * p, p, wheel_index[p % 30]});
+        }
+
+        constexpr uint64_t segment_bytes = 32 * 1024;
+
+        for (uint64_t low = 0; low < byte_count; low += segment_bytes)
+        {
+            const uint64_t high = std::min(low + segment_bytes, byte_count);
+            std::fill(bytes.begin() + low, bytes.begin() + high, uint8_t{0xFF});
+
+            for (auto& [multiple, p, q_index] : crossings)
+            {
+                // every p * q with q coprime to 30 is coprime to 30 as well - no multiple is wasted
+                for (; multiple < high * 30; q_index = (q_index + 1) % 8)
+                {
+                    bytes[multiple / 30] &= ~wheel_bits[multiple % 30];
+                    multiple += p * wheel_gaps[q_index];
+                }
+            }
+        }
+
+        bytes[0] &= ~wheel_bits[1]; // 1 is not a prime
+
+        for (uint64_t k = (limit - 1) / 30, r = (limit - 1) % 30 + 1; r < 30; ++r) // numbers >= limit in the last byte
+            bytes[k] &= ~wheel_bits[r];
+
+        return bytes;
+    }
+} // namespace
+
+PrimeBitmap::PrimeBitmap(uint64_t limit)
+    : limit_{std::min(limit, max_limit)}
+{
+    const auto bytes = sieve_wheel_bytes(limit_);
+
+    words_.resize(bytes.size() / 8);
+    for (size_t k = 0; k < bytes.size(); ++k)
+        words_[k / 8] |= uint64_t{bytes[k]} << (8 * (k % 8));
+
+    const size_t blocks = (words_.size() + words_per_block - 1) / words_per_block;
+    block_ranks_.resize(blocks + 1);
+
+    uint64_t rank = 0;
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        block_ranks_[block] = static_cast<uint32_t>(rank);
+
+        const size_t end = std::min(words_.size(), (block + 1) * words_per_block);
+        for (size_t w = block * words_per_block; w < end; ++w)
+        {
+            const uint64_t ones = std::popcount(words_[w]);
+            for (uint64_t sample = (rank + select_sample_rate - 1) / select_sample_rate * select_sample_rate; sample < rank + ones; sample += select_sample_rate)
+                select_samples_.push_back(static_cast<uint32_t>(block));
+            rank += ones;
+        }
+    }
+    block_ranks_[blocks] = static_cast<uint32_t>(rank);
+}
+
+uint64_t PrimeBitmap::prime_count() const noexcept
+{
+    return block_ranks_.back() + (limit_ > 2) + (limit_ > 3) + (limit_ > 5);
+}
+
+bool PrimeBitmap::is_prime(uint64_t n) const
+{
+    if (n >= limit_)
+        throw std::out_of_range("PrimeBitmap::is_prime - n is not below limit");
+
+    if (n < 7)
+        return n == 2 || n == 3 || n == 5;
+
+    const uint64_t byte = n / 30;
+    return (words_[byte / 8] >> (8 * (byte % 8)) & wheel_bits[n % 30]) != 0;
+}
+
+uint64_t PrimeBitmap::prime_pi(uint64_t n) const
+{
+    if (n >= limit_)
+        throw std::out_of_range("PrimeBitmap::prime_pi - n is not below limit");
+
+    uint64_t count = (n >= 2) + (n >= 3) + (n >= 5);
+    if (n < 7)
+        return count;
+
+    const uint64_t byte = n / 30;
+    const uint64_t word = byte / 8;
+    const uint64_t shift = 8 * (byte % 8);
+    const uint64_t mask = ((uint64_t{1} << shift) - 1) | uint64_t{wheel_bits_up_to[n % 30]} << shift;
+
+    count += block_ranks_[word / words_per_block];
+    for (uint64_t w = word / words_per_block * words_per_block; w < word; ++w)
+        count += std::popcount(words_[w]);
+
+    return count + std::popcount(words_[word] & mask);
+}
+
+uint64_t PrimeBitmap::nth_prime(uint64_t k) const
+{
+    if (k == 0 || k > prime_count())
+        throw std::out_of_range("PrimeBitmap::nth_prime - k is out of range");
+
+    if (k <= 3)
+        return std::array<uint64_t, 3>{2, 3, 5}[k - 1];
+
+    const uint64_t rank = k - 4; // 0-based rank among primes > 5
+
+    // samples bound the blocks to search: the answer lies between two consecutive samples
+    const size_t sample = rank / select_sample_rate;
+    const size_t first_block = select_samples_[sample];
+    const size_t last_block = sample + 1 < select_samples_.size() ? select_samples_[sample + 1] : block_ranks_.size() - 2;
+
+    const auto block_it = std::upper_bound(block_ranks_.begin() + first_block, block_ranks_.begin() + last_block + 1, rank);
+    const size_t block = static_cast<size_t>(block_it - block_ranks_.begin()) - 1;
+
+    uint64_t remaining = rank - block_ranks_[block];
+    for (size_t w = block * words_per_block;; ++w)
+    {
+        const uint64_t ones = std::popcount(words_[w]);
+        if (remaining >= ones)
+        {
+            remaining -= ones;
+            continue;
+        }
+
+        uint64_t bits = words_[w];
+        for (; remaining > 0; --remaining)
+            bits &= bits - 1;
+
+        const uint64_t bit = std::countr_zero(bits);
+        return 30 * (w * 8 + bit / 8) + wheel_residues[bit % 8];
+    }
+}
+
+size_t PrimeBitmap::memory_usage() const noexcept
+{
+    return words_.size() * sizeof(uint64_t) + block_ranks_.size() * sizeof(uint32_t) + select_samples_.size() * sizeof(uint32_t);
+}
+
 std::vector<uint32_t> get_primes_vec(uint32_t n)
 {
-    auto primes_view = std::views::iota(2u) | std::views::filter(is_prime) | std::views::take(n) | std::views::common;
+    return sieve_primes(nth_prime_upper_bound(n), n);
+}
+
+std::vector<uint32_t> get_primes_below(uint64_t limit)
+{
+    return sieve_primes(limit, SIZE_MAX);
+}
+
+namespace
+{
+    // floor(x^(1/k))
+    uint64_t integer_root(uint64_t x, int k)
+    {
+        auto power_fits = [x, k](uint64_t r) { // r^k <= x
+            uint64_t power = 1;
+            for (int i = 0; i < k; ++i)
+            {
+                if (r != 0 && power > x / r)
+                    return false;
+                power *= r;
+            }
+            return true;
+        };
+
+        uint64_t root = static_cast<uint64_t>(std::pow(static_cast<double>(x), 1.0 / k));
+        while (root > 0 && !power_fits(root))
+            --root;
+        while (power_fits(root + 1))
+            ++root;
+        return root;
+    }
+
+    // phi(x, a) - count of 1 <= n <= x divisible by none of the first a primes
+    class PhiCounter
+    {
+    public:
+        static constexpr size_t table_primes = 6;
+        static constexpr uint32_t table_period = 2 * 3 * 5 * 7 * 11 * 13;
+
+        PhiCounter(const std::vector<uint32_t>& primes, const PrimeBitmap& bitmap)
+            : primes_{primes}
+            , bitmap_{bitmap}
+        {
+            std::vector<uint8_t> coprime(table_period + 1, 1);
+            for (size_t a = 0; a <= table_primes; ++a)
+            {
+                if (a > 0)
+                {
+                    for (uint32_t multiple = primes_[a - 1]; multiple <= table_period; multiple += primes_[a - 1])
+                        coprime[multiple] = 0;
+                }
+
+                table_[a].resize(table_period + 1);
+                for (uint32_t n = 1; n <= table_period; ++n)
+                    table_[a][n] = static_cast<uint16_t>(table_[a][n - 1] + coprime[n]);
+            }
+        }
+
+        uint64_t operator()(uint64_t x, size_t a) const
+        {
+            if (a <= table_primes)
+                return x / table_period * table_[a][table_period] + table_[a][x % table_period];
+
+            const uint64_t p = primes_[a - 1];
+            if (x < p * p) // only 1 and the primes in (p_a, x] are left
+                return x < p ? (x > 0) : bitmap_.prime_pi(x) - a + 1;
+
+            return (*this)(x, table_primes) - leaves(x, table_primes + 1, a + 1);
+        }
+
+        // sum of phi(x / p_b, b - 1) for b in [first, last) - phi(x, a) == phi(x, 6) - leaves(x, 7, a + 1)
+        uint64_t leaves(uint64_t x, size_t first, size_t last) const
+        {
+            uint64_t sum = 0;
+            for (size_t b = first; b < last; ++b)
+                sum += (*this)(x / primes_[b - 1], b - 1);
+            return sum;
+        }
+
+    private:
+        const std::vector<uint32_t>& primes_; // primes up to sqrt(x) - at least the first table_primes
+        const PrimeBitmap& bitmap_;           // pi(y) for y < p_a^2 <= x^(2/3)
+        std::array<std::vector<uint16_t>, table_primes + 1> table_;
+    };
+} // namespace
+
+uint64_t prime_pi(uint64_t x, unsigned max_threads)
+{
+    if (x >= uint64_t{1} << 48)
+        throw std::out_of_range("prime_pi - x must be below 2^48");
+
+    if (x < 1'000'000)
+        return PrimeBitmap{x + 1}.prime_count();
+
+    // pi(x) = phi(x, a) + a - 1 - P2(x, a) with a = pi(x^(1/3)),
+    // P2(x, a) = sum of pi(x / p_b) - (b - 1) over the primes x^(1/3) < p_b <= x^(1/2)
+    const uint64_t cube_root = integer_root(x, 3);
+    const uint64_t square_root = integer_root(x, 2);
+
+    const PrimeBitmap bitmap{x / cube_root + 1};
+    const std::vector<uint32_t> primes = get_primes_below(square_root + 1);
+    const size_t a = bitmap.prime_pi(cube_root);
+
+    uint64_t p2 = 0;
+    for (size_t b = a + 1; b <= primes.size(); ++b)
+        p2 += bitmap.prime_pi(x / primes[b - 1]) - (b - 1);
+
+    // special leaves phi(x / p_b, b - 1) differ a lot in cost - threads take the next b from a shared counter
+    const PhiCounter phi{primes, bitmap};
+    const unsigned thread_count = std::max(1u, max_threads);
+
+    std::atomic<size_t> next_b = PhiCounter::table_primes + 1;
+    std::vector<uint64_t> thread_sums(thread_count);
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (size_t b = next_b++; b <= a; b = next_b++)
+                    thread_sums[t] += phi.leaves(x, b, b + 1);
+            });
+        }
+    }
+
+    uint64_t phi_x_a = phi(x, PhiCounter::table_primes);
+    for (uint64_t sum : thread_sums)
+        phi_x_a -= sum;
+
+    return phi_x_a + a - 1 - p2;
+}
+
+struct PrimeCache::Segment
+{
+    static constexpr size_t words = segment_span / 128; // one bit per odd number
+    static constexpr size_t words_per_block = 8;
+
+    uint64_t low;
+    uint64_t first_rank;  // number of primes below low
+    uint64_t prime_count; // number of primes in [low, low + segment_span)
+    std::array<uint64_t, words> bits{};  // bit i is set if low + 2 * i + 1 is a prime
+    std::array<uint32_t, words / words_per_block> block_ranks{}; // odd primes in the blocks before
+
+    Segment(uint64_t low, uint64_t first_rank, const std::vector<uint32_t>& base_primes)
+        : low{low}
+        , first_rank{first_rank}
+    {
+        bits.fill(~uint64_t{0});
+        if (low == 0)
+            bits[0] &= ~uint64_t{1}; // 1 is not a prime
+
+        const uint64_t high = low + segment_span;
+        for (uint64_t p : base_primes)
+        {
+            if (p * p >= high)
+                break;
+
+            uint64_t multiple = std::max(p * p, (low + p - 1) / p * p);
+            if (multiple % 2 == 0)
+                multiple += p;
+
+            for (; multiple < high; multiple += 2 * p)
+            {
+                const uint64_t bit = (multiple - low) / 2;
+                bits[bit / 64] &= ~(uint64_t{1} << (bit % 64));
+            }
+        }
+
+        uint32_t rank = 0;
+        for (size_t w = 0; w < words; ++w)
+        {
+            if (w % words_per_block == 0)
+                block_ranks[w / words_per_block] = rank;
+            rank += std::popcount(bits[w]);
+        }
+
+        prime_count = rank + (low == 0); // 2 is the only even prime
+    }
+
+    bool is_prime(uint64_t n) const
+    {
+        if (n % 2 == 0)
+            return n == 2;
+
+        const uint64_t bit = (n - low) / 2;
+        return (bits[bit / 64] >> (bit % 64) & 1) != 0;
+    }
+
+    // prime with given 0-based rank in this segment
+    uint64_t select(uint64_t rank) const
+    {
+        if (low == 0)
+        {
+            if (rank == 0)
+                return 2;
+            --rank;
+        }
+
+        const auto block_it = std::upper_bound(block_ranks.begin(), block_ranks.end(), rank);
+        size_t w = static_cast<size_t>(block_it - block_ranks.begin() - 1) * words_per_block;
+        rank -= block_ranks[w / words_per_block];
+
+        for (; rank >= static_cast<uint64_t>(std::popcount(bits[w])); ++w)
+            rank -= std::popcount(bits[w]);
+
+        uint64_t word = bits[w];
+        for (; rank > 0; --rank)
+            word &= word - 1;
+
+        return low + 2 * (w * 64 + std::countr_zero(word)) + 1;
+    }
+};
+
+PrimeCache& PrimeCache::shared()
+{
+    static PrimeCache cache;
+    return cache;
+}
 
-    std::vector<uint32_t> primes(primes_view.begin(), primes_view.end());
+PrimeCache::PrimeCache()
+    : base_primes_{odd_primes_up_to(1 << 16)}
+{
+}
 
-    return primes;
+PrimeCache::~PrimeCache()
+{
+    for (size_t i = 0; i < published_.load(); ++i)
+        delete segments_[i].load();
 }
+
+bool PrimeCache::is_prime(uint64_t n)
+{
+    if (n >= max_limit)
+        throw std::out_of_range("PrimeCache::is_prime - n is too large");
+
+    const size_t index = n / segment_span;
+    if (index >= published_.load(std::memory_order_acquire))
+        extend_to(index + 1);
+
+    // acquiring published_ made the segment pointer and its contents visible
+    return segments_[index].load(std::memory_order_relaxed)->is_prime(n);
+}
+
+uint64_t PrimeCache::nth_prime(uint64_t k)
+{
+    constexpr uint64_t max_k = 203'280'221; // pi(2^32)
+    if (k == 0 || k > max_k)
+        throw std::out_of_range("PrimeCache::nth_prime - k is out of range");
+
+    size_t count = published_.load(std::memory_order_acquire);
+    auto segment_at = [this](size_t i) { return segments_[i].load(std::memory_order_relaxed); };
+
+    if (count == 0 || segment_at(count - 1)->first_rank + segment_at(count - 1)->prime_count < k)
+        count = extend_to((nth_prime_upper_bound(static_cast<uint32_t>(k)) + segment_span - 1) / segment_span);
+
+    // first segment whose primes reach rank k
+    size_t first = 0;
+    size_t last = count - 1;
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        const Segment* segment = segment_at(middle);
+        if (segment->first_rank + segment->prime_count < k)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    const Segment* segment = segment_at(first);
+    return segment->select(k - 1 - segment->first_rank);
+}
+
+void PrimeCache::reserve(uint64_t limit)
+{
+    extend_to((std::min(limit, max_limit) + segment_span - 1) / segment_span);
+}
+
+uint64_t PrimeCache::cached_limit() const noexcept
+{
+    return published_.load(std::memory_order_acquire) * segment_span;
+}
+
+// sieves segments one after another and publishes each as soon as it is complete - readers of already
+// published segments are never blocked; returns the number of published segments
+size_t PrimeCache::extend_to(size_t segment_count)
+{
+    segment_count = std::min(segment_count, max_segments);
+
+    std::lock_guard lock{extend_mutex_};
+
+    size_t count = published_.load(std::memory_order_relaxed);
+    for (; count < segment_count; ++count)
+    {
+        const Segment* previous = count > 0 ? segments_[count - 1].load(std::memory_order_relaxed) : nullptr;
+        const uint64_t first_rank = previous ? previous->first_rank + previous->prime_count : 0;
+
+        segments_[count].store(new Segment{count * segment_span, first_rank, base_primes_}, std::memory_order_relaxed);
+        published_.store(count + 1, std::memory_order_release);
+    }
+
+    return count;
+}
+
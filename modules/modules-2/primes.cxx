@@ -1,8 +1,11 @@
 module; // global fragment module
 
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 export module Primes; // declaration of module Primes - primary module interface unit
@@ -15,6 +18,84 @@ struct IsPrime
     bool operator()(uint32_t n) const;
 };
 
-export std::vector<uint32_t> get_primes_vec(uint32_t n);
+export std::vector<uint32_t> get_primes_vec(uint32_t n); // first n primes
+
+export std::vector<uint32_t> get_primes_below(uint64_t limit); // all primes p < limit (limit <= 2^32)
+
+export constinit auto is_prime = IsPrime{};
+
+// number of primes p <= x (x < 2^48) by the Meissel-Lehmer method - needs only the primes up to x^(2/3);
+// the special leaves of phi(x, a) are split between max_threads threads
+export uint64_t prime_pi(uint64_t x, unsigned max_threads = std::thread::hardware_concurrency());
+
+// primes below limit (limit <= 2^32) as a mod-30 wheel bitmap: byte k has one bit for each of 30k + {1, 7, 11, 13, 17, 19, 23, 29},
+// the only residues that can be primes > 5 - about 1 byte per 30 integers instead of 4 bytes per prime;
+// a rank index of cumulative counts per block of words gives O(1) prime_pi and a sampled select index nth_prime
+export class PrimeBitmap
+{
+public:
+    explicit PrimeBitmap(uint64_t limit);
+
+    uint64_t limit() const noexcept
+    {
+        return limit_;
+    }
+
+    uint64_t prime_count() const noexcept; // number of primes p < limit
+
+    bool is_prime(uint64_t n) const; // n < limit
+
+    uint64_t prime_pi(uint64_t n) const; // number of primes p <= n, n < limit
+
+    uint64_t nth_prime(uint64_t k) const; // k-th prime counted from nth_prime(1) == 2, k <= prime_count()
+
+    size_t memory_usage() const noexcept; // bytes used by the bitmap and its indexes
+
+private:
+    static constexpr size_t words_per_block = 8;  // rank counter every 64 bytes (1920 integers)
+    static constexpr uint64_t select_sample_rate = 4096; // block of every 4096-th prime is stored for nth_prime
+
+    uint64_t limit_;
+    std::vector<uint64_t> words_;
+    std::vector<uint32_t> block_ranks_;    // primes > 5 in blocks before block b
+    std::vector<uint32_t> select_samples_; // block holding the (s * select_sample_rate + 1)-th prime > 5
+};
+
+// growable prime table shared between threads - the numbers are sieved in immutable segments that are
+// published once and never modified, so is_prime and nth_prime read them without any lock;
+// only a thread that needs a not yet sieved range takes the mutex and extends the table
+export class PrimeCache
+{
+public:
+    static constexpr uint64_t max_limit = uint64_t{1} << 32;
+
+    static PrimeCache& shared(); // process-wide instance
+
+    PrimeCache();
+    ~PrimeCache();
+
+    PrimeCache(const PrimeCache&) = delete;
+    PrimeCache& operator=(const PrimeCache&) = delete;
+
+    bool is_prime(uint64_t n); // n < max_limit
+
+    uint64_t nth_prime(uint64_t k); // k-th prime counted from nth_prime(1) == 2, p(k) < max_limit
+
+    void reserve(uint64_t limit); // sieves all numbers below limit
+
+    uint64_t cached_limit() const noexcept; // numbers below are served without extending the table
+
+private:
+    struct Segment;
+
+    static constexpr uint64_t segment_span = uint64_t{1} << 20;
+    static constexpr size_t max_segments = max_limit / segment_span;
+
+    std::vector<uint32_t> base_primes_; // odd primes below sqrt(max_limit)
+    std::array<std::atomic<const Segment*>, max_segments> segments_{};
+    std::atomic<size_t> published_{0};
+    std::mutex extend_mutex_;
+
+    size_t extend_to(size_t segment_count);
+};
 
-export constinit auto is_prime = IsPrime{};
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+import Primes; // importing module Primes
+
+namespace
+{
+    template <typename F>
+    auto measure(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto result = f();
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        return std::pair{std::move(result), elapsed.count()};
+    }
+} // namespace
+
+int main()
+{
+    std::cout << "Trial division (views::filter(is_prime)) - first n primes\n";
+    for (uint32_t n : {1'000u, 3'000u})
+    {
+        auto [primes, ms] = measure([n] {
+            auto primes_view = std::views::iota(2u) | std::views::filter(is_prime) | std::views::take(n) | std::views::common;
+            return std::vector<uint32_t>(primes_view.begin(), primes_view.end());
+        });
+        std::cout << "  n = " << n << ": " << ms << " ms (last: " << primes.back() << ")\n";
+    }
+
+    std::cout << "Segmented sieve - get_primes_vec(n)\n";
+    for (uint32_t n : {10'000u, 100'000u, 1'000'000u, 10'000'000u, 100'000'000u})
+    {
+        auto [primes, ms] = measure([n] { return get_primes_vec(n); });
+        std::cout << "  n = " << n << ": " << ms << " ms (last: " << primes.back() << ")\n";
+    }
+
+    std::cout << "Segmented sieve - get_primes_below(x)\n";
+    for (uint64_t x : {10'000ull, 100'000ull, 1'000'000ull, 10'000'000ull, 100'000'000ull})
+    {
+        auto [primes, ms] = measure([x] { return get_primes_below(x); });
+        std::cout << "  x = " << x << ": " << ms << " ms (pi(x) = " << primes.size() << ")\n";
+    }
+
+    std::cout << "Wheel bitmap - PrimeBitmap(x) vs sorted vector\n";
+    for (uint64_t x : {10'000'000ull, 100'000'000ull, 1'000'000'000ull})
+    {
+        auto [bitmap, build_ms] = measure([x] { return PrimeBitmap{x}; });
+        const auto primes = get_primes_below(x);
+        std::cout << "  x = " << x << ": build " << build_ms << " ms, " << bitmap.memory_usage() / 1024 << " KiB vs "
+                  << primes.size() * sizeof(uint32_t) / 1024 << " KiB\n";
+
+        std::mt19937_64 rnd{42};
+        std::vector<uint64_t> queries(1'000'000);
+        for (auto& q : queries)
+            q = rnd() % x;
+
+        auto [bitmap_hits, bitmap_ms] = measure([&] { return std::ranges::count_if(queries, [&](uint64_t n) { return bitmap.is_prime(n); }); });
+        auto [vector_hits, vector_ms] = measure([&] { return std::ranges::count_if(queries, [&](uint64_t n) { return std::ranges::binary_search(primes, n); }); });
+        std::cout << "    is_prime x 10^6: bitmap " << bitmap_ms << " ms, binary search " << vector_ms << " ms (hits: " << bitmap_hits << "/" << vector_hits << ")\n";
+
+        for (auto& q : queries)
+            q = rnd() % primes.size() + 1;
+
+        auto [bitmap_sum, nth_ms] = measure([&] {
+            uint64_t sum = 0;
+            for (uint64_t k : queries)
+                sum += bitmap.nth_prime(k);
+            return sum;
+        });
+        auto [pi_sum, pi_ms] = measure([&] {
+            uint64_t sum = 0;
+            for (uint64_t k : queries)
+                sum += bitmap.prime_pi(primes[k - 1]);
+            return sum;
+        });
+        std::cout << "    nth_prime x 10^6: " << nth_ms << " ms, prime_pi x 10^6: " << pi_ms << " ms (checksums: " << bitmap_sum << ", " << pi_sum << ")\n";
+    }
+
+    std::cout << "Meissel-Lehmer - prime_pi(x)\n";
+    for (uint64_t x : {1'000ull, 1'000'000ull, 12'345'678ull, 100'000'000ull, 1'000'000'000ull})
+    {
+        const uint64_t expected = get_primes_below(x + 1).size();
+        const uint64_t pi = prime_pi(x);
+        std::cout << "  x = " << x << ": pi(x) = " << pi << (pi == expected ? " (matches sieve)\n" : " (MISMATCH with sieve)\n");
+    }
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    for (uint64_t x : {10'000'000'000ull, 1'000'000'000'000ull, 10'000'000'000'000ull})
+    {
+        for (unsigned threads : thread_counts)
+        {
+            auto [pi, ms] = measure([=] { return prime_pi(x, threads); });
+            std::cout << "  x = " << x << ", " << threads << " threads: " << ms << " ms (pi(x) = " << pi << ")\n";
+        }
+    }
+}
+
@@ -11,4 +11,7 @@ int main()
     for (const auto& n : get_primes_vec(10))
         std::cout << n << " ";
     std::cout << "\n";
+
+    const PrimeBitmap bitmap{1'000'000};
+    std::cout << "pi(10^6 - 1) = " << bitmap.prime_pi(999'999) << ", 1000th prime = " << bitmap.nth_prime(1'000) << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+import Primes; // importing module Primes
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, std::string_view what, uint64_t x)
+    {
+        if (!condition)
+        {
+            ++failures;
+            std::cout << "FAILED: " << what << " for x = " << x << "\n";
+        }
+    }
+
+    // plain sieve of Eratosthenes - reference for the segmented sieve
+    std::vector<uint32_t> plain_sieve_below(uint64_t limit)
+    {
+        std::vector<bool> composite(limit);
+        std::vector<uint32_t> primes;
+
+        for (uint64_t n = 2; n < limit; ++n)
+        {
+            if (composite[n])
+                continue;
+
+            primes.push_back(static_cast<uint32_t>(n));
+            for (uint64_t multiple = n * n; multiple < limit; multiple += n)
+                composite[multiple] = true;
+        }
+
+        return primes;
+    }
+} // namespace
+
+int main()
+{
+    constexpr uint64_t segment_span = 524'288; // numbers covered by one segment of get_primes_below
+
+    // a short last segment has base primes without any multiple in it
+    const auto reference = plain_sieve_below(4 * segment_span + 1'000);
+    for (uint64_t segment = 1; segment <= 4; ++segment)
+    {
+        for (uint64_t limit = segment * segment_span - 2; limit < segment * segment_span + 1'000; ++limit)
+        {
+            const std::vector<uint32_t> expected(reference.begin(), std::ranges::lower_bound(reference, limit));
+            check(get_primes_below(limit) == expected, "get_primes_below", limit);
+        }
+    }
+
+    for (uint32_t n : {1u, 2u, 3u, 10u, 1'000u})
+        check(get_primes_vec(n) == std::vector<uint32_t>(reference.begin(), reference.begin() + n), "get_primes_vec", n);
+
+    for (uint64_t x : {1'000'000ull, 12'345'678ull})
+        check(prime_pi(x) == get_primes_below(x + 1).size(), "prime_pi vs get_primes_below", x);
+
+    check(prime_pi(10'000'000'000ull) == 455'052'511, "prime_pi", 10'000'000'000ull);
+
+    // primes up to sqrt(x) + 1 == 525287 are sieved with a short last segment
+    check(prime_pi(275'925'500'000ull) == 10'906'034'948, "prime_pi", 275'925'500'000ull);
+
+    std::cout << (failures == 0 ? "All checks passed\n" : "Some checks failed\n");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,398 @@
+module;
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+export module Math:BigUnsigned;
+
+namespace Math::details
+{
+    // limbs are stored little-endian in base 2^64 (arithmetic) or 10^18 (decimal conversion);
+    // the same kernels serve both radixes - Wide holds limb * limb + limb + carry
+    struct BinaryRadix
+    {
+        using Limb = uint64_t;
+        using Wide = unsigned __int128;
+
+        static constexpr Wide base = Wide{1} << 64;
+
+        static constexpr Limb low(Wide value) { return static_cast<Limb>(value); }
+        static constexpr Wide high(Wide value) { return value >> 64; }
+
+        // value < 2 * base - the limb and the carry
+        static constexpr std::pair<Limb, Limb> split_sum(Wide value) { return {low(value), static_cast<Limb>(high(value))}; }
+    };
+
+    struct DecimalRadix
+    {
+        using Limb = uint64_t;
+        using Wide = unsigned __int128;
+
+        static constexpr Wide base = 1'000'000'000'000'000'000;
+        static constexpr int digits = 18;
+
+        static constexpr Limb low(Wide value) { return static_cast<Limb>(value % base); }
+        static constexpr Wide high(Wide value) { return value / base; }
+
+        static constexpr std::pair<Limb, Limb> split_sum(Wide value)
+        {
+            return value >= base ? std::pair{static_cast<Limb>(value - base), Limb{1}} : std::pair{static_cast<Limb>(value), Limb{0}};
+        }
+    };
+
+    template <typename Limb>
+    std::span<const Limb> trimmed(std::span<const Limb> limbs)
+    {
+        while (!limbs.empty() && limbs.back() == 0)
+            limbs = limbs.first(limbs.size() - 1);
+        return limbs;
+    }
+
+    template <typename Limb>
+    void trim(std::vector<Limb>& limbs)
+    {
+        while (!limbs.empty() && limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+    // acc += x; the sum must fit in acc
+    template <typename Radix>
+    void add_into(std::span<typename Radix::Limb> acc, std::span<const typename Radix::Limb> x)
+    {
+        x = trimmed(x);
+
+        typename Radix::Limb carry = 0;
+        for (size_t i = 0; i < x.size() || carry != 0; ++i)
+        {
+            const auto sum = typename Radix::Wide{acc[i]} + (i < x.size() ? x[i] : 0) + carry;
+            std::tie(acc[i], carry) = Radix::split_sum(sum);
+        }
+    }
+
+    // acc -= x; requires acc >= x
+    template <typename Radix>
+    void subtract_from(std::span<typename Radix::Limb> acc, std::span<const typename Radix::Limb> x)
+    {
+        x = trimmed(x);
+
+        typename Radix::Limb borrow = 0;
+        for (size_t i = 0; i < x.size() || borrow != 0; ++i)
+        {
+            // acc + base - x - borrow carries exactly when nothing is borrowed
+            const auto difference = typename Radix::Wide{acc[i]} + Radix::base - (i < x.size() ? x[i] : 0) - borrow;
+            typename Radix::Limb no_borrow;
+            std::tie(acc[i], no_borrow) = Radix::split_sum(difference);
+            borrow = 1 - no_borrow;
+        }
+    }
+
+    // out = a * b, out.size() == a.size() + b.size()
+    template <typename Radix>
+    void multiply_schoolbook(std::span<typename Radix::Limb> out, std::span<const typename Radix::Limb> a,
+        std::span<const typename Radix::Limb> b)
+    {
+        std::ranges::fill(out, 0);
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            typename Radix::Wide carry = 0;
+            for (size_t j = 0; j < b.size(); ++j)
+            {
+                const auto product = typename Radix::Wide{a[i]} * b[j] + out[i + j] + carry;
+                out[i + j] = Radix::low(product);
+                carry = Radix::high(product);
+            }
+            out[i + b.size()] = static_cast<typename Radix::Limb>(carry);
+        }
+    }
+
+    // decimal limbs - the products are summed in 128-bit cells and the carries are propagated once at the end
+    // (threshold * (10^18 - 1)^2 stays far below 2^128), which keeps the division out of the inner loop
+    template <>
+    void multiply_schoolbook<DecimalRadix>(std::span<DecimalRadix::Limb> out, std::span<const DecimalRadix::Limb> a,
+        std::span<const DecimalRadix::Limb> b)
+    {
+        std::vector<DecimalRadix::Wide> cells(out.size());
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            for (size_t j = 0; j < b.size(); ++j)
+                cells[i + j] += DecimalRadix::Wide{a[i]} * b[j];
+        }
+
+        DecimalRadix::Wide carry = 0;
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            const auto value = cells[i] + carry;
+            out[i] = DecimalRadix::low(value);
+            carry = DecimalRadix::high(value);
+        }
+    }
+
+    // out = a * b, out.size() == a.size() + b.size(); operands shorter than threshold limbs
+    // are multiplied by schoolbook - the recursion overhead does not pay off for them
+    template <typename Radix>
+    void multiply_karatsuba(std::span<typename Radix::Limb> out, std::span<const typename Radix::Limb> a,
+        std::span<const typename Radix::Limb> b, size_t threshold)
+    {
+        using Limb = typename Radix::Limb;
+
+        if (a.size() < b.size())
+            std::swap(a, b);
+
+        if (b.size() < threshold)
+        {
+            multiply_schoolbook<Radix>(out, a, b);
+            return;
+        }
+
+        // unbalanced operands - a is cut into b-sized chunks
+        if (a.size() >= 2 * b.size())
+        {
+            std::ranges::fill(out, 0);
+            std::vector<Limb> partial(2 * b.size());
+            for (size_t offset = 0; offset < a.size(); offset += b.size())
+            {
+                const auto chunk = a.subspan(offset, std::min(b.size(), a.size() - offset));
+                const auto product = std::span{partial}.first(chunk.size() + b.size());
+                multiply_karatsuba<Radix>(product, chunk, b, threshold);
+                add_into<Radix>(out.subspan(offset), product);
+            }
+            return;
+        }
+
+        // a = a1 * B^m + a0, b = b1 * B^m + b0
+        // a * b = a1 * b1 * B^2m + ((a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1) * B^m + a0 * b0
+        const size_t m = a.size() / 2;
+        const auto a0 = a.first(m);
+        const auto a1 = a.subspan(m);
+        const auto b0 = b.first(m);
+        const auto b1 = b.subspan(m);
+
+        multiply_karatsuba<Radix>(out.first(2 * m), a0, b0, threshold);
+        multiply_karatsuba<Radix>(out.subspan(2 * m), a1, b1, threshold);
+
+        std::vector<Limb> a_sum(std::max(a0.size(), a1.size()) + 1);
+        std::ranges::copy(a1, a_sum.begin());
+        add_into<Radix>(a_sum, a0);
+
+        std::vector<Limb> b_sum(std::max(b0.size(), b1.size()) + 1);
+        std::ranges::copy(b1, b_sum.begin());
+        add_into<Radix>(b_sum, b0);
+
+        const auto a_sum_limbs = trimmed(std::span<const Limb>{a_sum});
+        const auto b_sum_limbs = trimmed(std::span<const Limb>{b_sum});
+
+        std::vector<Limb> middle(a_sum_limbs.size() + b_sum_limbs.size());
+        multiply_karatsuba<Radix>(middle, a_sum_limbs, b_sum_limbs, threshold);
+        subtract_from<Radix>(middle, out.first(2 * m));
+        subtract_from<Radix>(middle, out.subspan(2 * m));
+        add_into<Radix>(out.subspan(m), middle);
+    }
+
+    template <typename Radix>
+    std::vector<typename Radix::Limb> multiply(std::span<const typename Radix::Limb> a, std::span<const typename Radix::Limb> b,
+        size_t threshold)
+    {
+        a = trimmed(a);
+        b = trimmed(b);
+        if (a.empty() || b.empty())
+            return {};
+
+        std::vector<typename Radix::Limb> product(a.size() + b.size());
+        multiply_karatsuba<Radix>(product, a, b, threshold);
+        trim(product);
+        return product;
+    }
+} // namespace Math::details
+
+export namespace Math
+{
+    // crossover measured by big_unsigned_bench - below it schoolbook wins
+    inline constexpr size_t karatsuba_threshold = 32;
+
+    // arbitrary-precision unsigned integer - little-endian 64-bit limbs without leading zeros
+    class BigUnsigned
+    {
+        std::vector<uint64_t> limbs_;
+
+        explicit BigUnsigned(std::vector<uint64_t> limbs)
+            : limbs_{std::move(limbs)}
+        {
+            details::trim(limbs_);
+        }
+
+    public:
+        BigUnsigned() = default;
+
+        BigUnsigned(uint64_t value)
+        {
+            if (value != 0)
+                limbs_.push_back(value);
+        }
+
+        std::span<const uint64_t> limbs() const
+        {
+            return limbs_;
+        }
+
+        bool is_zero() const
+        {
+            return limbs_.empty();
+        }
+
+        size_t bit_width() const
+        {
+            return limbs_.empty() ? 0 : 64 * (limbs_.size() - 1) + std::bit_width(limbs_.back());
+        }
+
+        friend bool operator==(const BigUnsigned&, const BigUnsigned&) = default;
+
+        friend BigUnsigned operator+(const BigUnsigned& a, const BigUnsigned& b)
+        {
+            std::vector<uint64_t> sum(std::max(a.limbs_.size(), b.limbs_.size()) + 1);
+            std::ranges::copy(a.limbs_, sum.begin());
+            details::add_into<details::BinaryRadix>(sum, b.limbs_);
+            return BigUnsigned{std::move(sum)};
+        }
+
+        // requires a >= b
+        friend BigUnsigned operator-(const BigUnsigned& a, const BigUnsigned& b)
+        {
+            std::vector<uint64_t> difference = a.limbs_;
+            details::subtract_from<details::BinaryRadix>(difference, b.limbs_);
+            return BigUnsigned{std::move(difference)};
+        }
+
+        friend BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b)
+        {
+            return multiply_karatsuba(a, b);
+        }
+
+        static BigUnsigned multiply_schoolbook(const BigUnsigned& a, const BigUnsigned& b)
+        {
+            return BigUnsigned{details::multiply<details::BinaryRadix>(a.limbs_, b.limbs_, SIZE_MAX)};
+        }
+
+        static BigUnsigned multiply_karatsuba(const BigUnsigned& a, const BigUnsigned& b, size_t threshold = karatsuba_threshold)
+        {
+            return BigUnsigned{details::multiply<details::BinaryRadix>(a.limbs_, b.limbs_, std::max<size_t>(threshold, 2))};
+        }
+
+        // decimal digits - subquadratic: the upper half of the limbs is converted recursively and scaled
+        // by 2^(64 * m) computed in base 10^18, so the work is dominated by Karatsuba multiplications
+        std::string to_string() const;
+    };
+} // namespace Math
+
+namespace Math::details
+{
+    using DecimalLimbs = std::vector<DecimalRadix::Limb>;
+
+    // below this many 64-bit limbs quadratic division by 10^9 is faster than splitting
+    inline constexpr size_t decimal_split_threshold = 64;
+
+    DecimalLimbs to_decimal_quadratic(std::span<const uint64_t> binary)
+    {
+        constexpr uint64_t billion = 1'000'000'000;
+
+        // 32-bit halves - the running remainder * 2^32 + half fits in 64 bits
+        std::vector<uint32_t> halves;
+        halves.reserve(2 * binary.size());
+        for (uint64_t limb : binary)
+        {
+            halves.push_back(static_cast<uint32_t>(limb));
+            halves.push_back(static_cast<uint32_t>(limb >> 32));
+        }
+        trim(halves);
+
+        // repeated division by 10^9, pairs of remainders form one 10^18 limb
+        std::vector<uint64_t> billions;
+        while (!halves.empty())
+        {
+            uint64_t remainder = 0;
+            for (size_t i = halves.size(); i-- > 0;)
+            {
+                const uint64_t current = (remainder << 32) | halves[i];
+                halves[i] = static_cast<uint32_t>(current / billion);
+                remainder = current % billion;
+            }
+            billions.push_back(remainder);
+            trim(halves);
+        }
+
+        DecimalLimbs decimal((billions.size() + 1) / 2);
+        for (size_t i = 0; i < billions.size(); ++i)
+            decimal[i / 2] += i % 2 == 0 ? billions[i] : billions[i] * billion;
+
+        return decimal;
+    }
+
+    // powers[k] = 2^(64 * 2^k) in base 10^18, extended by squaring on demand
+    const DecimalLimbs& decimal_power_of_two(std::vector<DecimalLimbs>& powers, size_t k)
+    {
+        if (powers.empty())
+            powers.push_back(to_decimal_quadratic(std::vector<uint64_t>{0, 1}));
+
+        while (powers.size() <= k)
+        {
+            const auto& last = powers.back();
+            powers.push_back(multiply<DecimalRadix>(last, last, karatsuba_threshold));
+        }
+
+        return powers[k];
+    }
+
+    DecimalLimbs to_decimal(std::span<const uint64_t> binary, std::vector<DecimalLimbs>& powers)
+    {
+        binary = trimmed(binary);
+        if (binary.size() < decimal_split_threshold)
+            return to_decimal_quadratic(binary);
+
+        // split at the largest power of two below the size, so only log(n) powers are needed
+        const size_t k = std::bit_width(binary.size() - 1) - 1;
+        const size_t m = size_t{1} << k;
+
+        const DecimalLimbs high = to_decimal(binary.subspan(m), powers);
+        const DecimalLimbs low = to_decimal(binary.first(m), powers);
+
+        DecimalLimbs result = multiply<DecimalRadix>(high, decimal_power_of_two(powers, k), karatsuba_threshold);
+        result.resize(std::max(result.size(), low.size()) + 1);
+        add_into<DecimalRadix>(result, low);
+        trim(result);
+        return result;
+    }
+} // namespace Math::details
+
+std::string Math::BigUnsigned::to_string() const
+{
+    if (limbs_.empty())
+        return "0";
+
+    std::vector<details::DecimalLimbs> powers;
+    const details::DecimalLimbs decimal = details::to_decimal(limbs_, powers);
+
+    std::string digits(details::DecimalRadix::digits * decimal.size(), '0');
+    char* const first = digits.data();
+
+    // the most significant limb without leading zeros, the others padded to 18 digits
+    char* end = std::to_chars(first, first + digits.size(), decimal.back()).ptr;
+    for (size_t i = decimal.size() - 1; i-- > 0;)
+    {
+        char* const limb_end = end + details::DecimalRadix::digits;
+        char buffer[details::DecimalRadix::digits];
+        char* const buffer_end = std::to_chars(buffer, buffer + sizeof(buffer), decimal[i]).ptr;
+        std::copy(buffer, buffer_end, limb_end - (buffer_end - buffer));
+        end = limb_end;
+    }
+
+    digits.resize(end - first);
+    return digits;
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+import Math;
+
+namespace
+{
+    template <typename F>
+    double measure_ms(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Math::BigUnsigned random_big_unsigned(std::mt19937_64& rnd, size_t limb_count)
+    {
+        const Math::BigUnsigned limb_base = Math::BigUnsigned{uint64_t{1} << 32} * Math::BigUnsigned{uint64_t{1} << 32};
+
+        Math::BigUnsigned value = rnd() | 1;
+        for (size_t i = 1; i < limb_count; ++i)
+            value = value * limb_base + Math::BigUnsigned{rnd()};
+        return value;
+    }
+} // namespace
+
+int main()
+{
+    std::mt19937_64 rnd{42};
+
+    std::cout << "multiplication of two n-limb numbers (64-bit limbs):\n";
+    for (size_t limb_count = 8; limb_count <= 16'384; limb_count *= 2)
+    {
+        const auto a = random_big_unsigned(rnd, limb_count);
+        const auto b = random_big_unsigned(rnd, limb_count);
+
+        // repeat small sizes to get measurable times
+        const int repetitions = static_cast<int>(std::max<size_t>(1, 1'000'000 / (limb_count * limb_count)));
+
+        Math::BigUnsigned schoolbook_product;
+        const double schoolbook_ms = measure_ms([&] {
+            for (int i = 0; i < repetitions; ++i)
+                schoolbook_product = Math::BigUnsigned::multiply_schoolbook(a, b);
+        }) / repetitions;
+
+        Math::BigUnsigned karatsuba_product;
+        const double karatsuba_ms = measure_ms([&] {
+            for (int i = 0; i < repetitions; ++i)
+                karatsuba_product = Math::BigUnsigned::multiply_karatsuba(a, b);
+        }) / repetitions;
+
+        std::cout << "  n = " << limb_count << ": schoolbook " << schoolbook_ms << " ms, karatsuba " << karatsuba_ms << " ms"
+                  << (schoolbook_product == karatsuba_product ? "" : " - MISMATCH!") << "\n";
+    }
+
+    std::cout << "\nkaratsuba threshold sweep (4096-limb operands, current threshold: " << Math::karatsuba_threshold << "):\n";
+    const auto a = random_big_unsigned(rnd, 4'096);
+    const auto b = random_big_unsigned(rnd, 4'096);
+    for (size_t threshold : {8, 16, 24, 32, 48, 64, 96, 128})
+    {
+        const double ms = measure_ms([&] { return Math::BigUnsigned::multiply_karatsuba(a, b, threshold); });
+        std::cout << "  threshold " << threshold << ": " << ms << " ms\n";
+    }
+
+    Math::BigUnsigned fibonacci;
+    const double fibonacci_ms = measure_ms([&] { fibonacci = Math::Fibonacci::fibonacci_big(10'000'000); });
+
+    std::string digits;
+    const double to_string_ms = measure_ms([&] { digits = fibonacci.to_string(); });
+
+    std::cout << "\nF(10^7): " << fibonacci.bit_width() << " bits computed in " << fibonacci_ms << " ms, " << digits.size()
+              << " decimal digits converted in " << to_string_ms << " ms\n";
+    std::cout << "  " << digits.substr(0, 20) << "..." << digits.substr(digits.size() - 20) << "\n";
+}
@@ -1,4 +1,5 @@
 export module Math;
 
 export import :Primes;
+export import :BigUnsigned;
 export import :Fibonacci;
\ No newline at end of file
@@ -1,12 +1,16 @@
 #include <cstdint>
 #include <iostream>
 #include <ranges>
+#include <string>
+
+#include "math_tables.hpp"
 
 import Math; // importing module Math
 
 int main()
 {
     std::cout << "check if 13 is prime: " << Math::Primes::is_prime(13) << "\n";
+    std::cout << "check if 2^64 - 59 is prime: " << Math::Primes::is_prime(18'446'744'073'709'551'557ULL) << "\n";
     // std::cout << "check if 42 is prime: " << IsPrime{}(42) << "\n";
 
     using Math::Primes::get_primes, Math::Primes::first_primes;
@@ -29,8 +33,23 @@ int main()
         std::cout << n << " ";
     std::cout << "\n";
 
+    std::cout << "Primes from lazy view: ";
+    for (const auto& p : Math::Primes::primes_view{} | std::views::drop(1'000) | std::views::take(5))
+        std::cout << p << " ";
+    std::cout << "...\n";
+
     std::cout << "Fibonacci lookup table: ";
     for(const auto& fib : Math::Fibonacci::fibonacci_lookup_table | std::views::take(15))
         std::cout << fib << " ";
     std::cout << "...\n";
+
+    std::cout << "F(93) as uint64_t: " << Math::Fibonacci::fibonacci_fast<uint64_t>(93) << "\n";
+    std::cout << "F(94) fits in uint64_t: " << Math::Fibonacci::fibonacci_checked<uint64_t>(94).has_value() << "\n";
+
+    const std::string f_1000 = Math::Fibonacci::fibonacci_big(1'000).to_string();
+    std::cout << "F(1000) has " << f_1000.size() << " digits: " << f_1000.substr(0, 20) << "...\n";
+
+    std::cout << "Generated prime table: " << Math::Tables::primes().size() << " primes, the last one is "
+              << Math::Tables::primes().back() << "\n";
+    std::cout << "Generated Fibonacci table: F(" << Math::Tables::fibonacci().size() - 1 << ") = " << Math::Tables::fibonacci().back() << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "math_tables.hpp"
+
+// MATH_PRIMES_BLOB & MATH_FIBONACCI_BLOB are paths of the generated files - set in CMakeLists.txt;
+// .incbin copies a file verbatim into read-only data (ELF targets), begin & end symbols give its extent
+// (#embed would do the same, but it is not available in C++ mode of the supported compilers yet);
+// other targets compile the generated math_tables_data.cpp instead of this file
+#define MATH_TABLES_INCBIN(name, path)       \
+    asm(".pushsection .rodata\n"             \
+        ".balign 64\n"                       \
+        ".globl " #name "_begin\n"           \
+        #name "_begin:\n"                    \
+        ".incbin \"" path "\"\n"             \
+        ".globl " #name "_end\n"             \
+        #name "_end:\n"                      \
+        ".popsection\n")
+
+MATH_TABLES_INCBIN(math_primes_blob, MATH_PRIMES_BLOB);
+MATH_TABLES_INCBIN(math_fibonacci_blob, MATH_FIBONACCI_BLOB);
+
+extern "C"
+{
+    extern const uint32_t math_primes_blob_begin[];
+    extern const uint32_t math_primes_blob_end[];
+    extern const uint64_t math_fibonacci_blob_begin[];
+    extern const uint64_t math_fibonacci_blob_end[];
+}
+
+std::span<const uint32_t> Math::Tables::primes()
+{
+    return {math_primes_blob_begin, math_primes_blob_end};
+}
+
+std::span<const uint64_t> Math::Tables::fibonacci()
+{
+    return {math_fibonacci_blob_begin, math_fibonacci_blob_end};
+}
@@ -0,0 +1,18 @@
+#ifndef MATH_TABLES_HPP
+#define MATH_TABLES_HPP
+
+#include <cstdint>
+#include <span>
+
+// tables generated at build time by math_tables_generator and linked in as binary blobs -
+// no constexpr evaluation when compiling and no work at startup
+namespace Math::Tables
+{
+    // the first PRIMES_TABLE_SIZE primes
+    std::span<const uint32_t> primes();
+
+    // F(0), ..., F(93) - every Fibonacci number that fits in uint64_t
+    std::span<const uint64_t> fibonacci();
+} // namespace Math::Tables
+
+#endif
@@ -0,0 +1,91 @@
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+import Math;
+
+// evaluated here at build time (at runtime of the generator) instead of in constant evaluation
+// of every translation unit that needs the tables - set per target in CMakeLists.txt
+#ifndef PRIMES_TABLE_SIZE
+#define PRIMES_TABLE_SIZE 1'000'000
+#endif
+
+namespace
+{
+    template <typename T>
+    void write_blob(const std::filesystem::path& path, std::span<const T> values)
+    {
+        std::ofstream out{path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+
+        if (!out)
+            throw std::runtime_error("cannot write " + path.string());
+
+        std::cout << "  " << path.filename().string() << ": " << values.size() << " values, " << values.size_bytes() << " bytes\n";
+    }
+
+    template <typename T>
+    void write_array(std::ostream& out, std::string_view type, std::string_view name, std::span<const T> values)
+    {
+        out << "alignas(64) const " << type << " " << name << "[] = {";
+        for (size_t i = 0; i < values.size(); ++i)
+            out << (i % 16 == 0 ? "\n    " : " ") << values[i] << (sizeof(T) == 8 ? "ull," : "u,");
+        out << "\n};\n\n";
+    }
+
+    // for object formats without .incbin support (COFF, Mach-O) - the tables as array definitions
+    void write_source(const std::filesystem::path& path, std::span<const uint32_t> primes, std::span<const uint64_t> fibonaccis)
+    {
+        std::ofstream out{path};
+        out << "// generated by math_tables_generator - do not edit\n\n"
+            << "#include \"math_tables.hpp\"\n\n"
+            << "namespace\n{\n";
+        write_array(out, "uint32_t", "primes_table", primes);
+        write_array(out, "uint64_t", "fibonacci_table", fibonaccis);
+        out << "} // namespace\n\n"
+            << "std::span<const uint32_t> Math::Tables::primes()\n{\n    return primes_table;\n}\n\n"
+            << "std::span<const uint64_t> Math::Tables::fibonacci()\n{\n    return fibonacci_table;\n}\n";
+
+        if (!out)
+            throw std::runtime_error("cannot write " + path.string());
+
+        std::cout << "  " << path.filename().string() << ": " << primes.size() << " primes, " << fibonaccis.size() << " Fibonacci numbers\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const bool as_source = argc == 3 && std::string_view{argv[2]} == "--source";
+
+    if (argc != 2 && !as_source)
+    {
+        std::cerr << "usage: " << argv[0] << " <output directory> [--source]\n";
+        return 1;
+    }
+
+    const std::filesystem::path output_directory{argv[1]};
+    std::filesystem::create_directories(output_directory);
+
+    // allocated directly on the heap - the table does not fit comfortably on the stack
+    const std::unique_ptr<const std::array<uint32_t, PRIMES_TABLE_SIZE>> primes{
+        new std::array<uint32_t, PRIMES_TABLE_SIZE>(Math::Primes::get_primes<PRIMES_TABLE_SIZE>())};
+
+    constexpr uint32_t fibonacci_count = Math::Fibonacci::fibonacci_max_index<uint64_t> + 1;
+    const auto fibonaccis = Math::Fibonacci::get_fibonacci_sequence<fibonacci_count, uint64_t>();
+
+    if (as_source)
+    {
+        write_source(output_directory / "math_tables_data.cpp", *primes, fibonaccis);
+        return 0;
+    }
+
+    write_blob<uint32_t>(output_directory / "primes.bin", *primes);
+    write_blob<uint64_t>(output_directory / "fibonacci.bin", fibonaccis);
+}
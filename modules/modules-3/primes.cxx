@@ -2,40 +2,477 @@ module; // global fragment module
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 export module Math:Primes;
 
 namespace Math::Primes
 {
-    export constexpr bool is_prime(uint32_t n)
+    // odd numbers below small_prime_limit are answered from a bitmap built at compile time
+    constexpr uint32_t small_prime_limit = 1024;
+
+    constexpr std::array<uint64_t, small_prime_limit / 128> small_primes_bitmap = [] {
+        std::array<uint64_t, small_prime_limit / 128> bitmap{};
+
+        for (uint32_t n = 3; n < small_prime_limit; n += 2)
+        {
+            bool prime = true;
+            for (uint32_t d = 3; d * d <= n && prime; d += 2)
+                prime = n % d != 0;
+
+            if (prime)
+                bitmap[n / 128] |= uint64_t{1} << (n / 2 % 64);
+        }
+
+        return bitmap;
+    }();
+
+    // a * b mod m without overflow
+    constexpr uint64_t mul_mod(uint64_t a, uint64_t b, uint64_t m)
     {
-        if (n <= 1)
-            return false;
+        if (m <= std::numeric_limits<uint32_t>::max())
+            return (a % m) * (b % m) % m;
+
+#ifdef __SIZEOF_INT128__
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+#else
+        uint64_t result = 0;
+        for (a %= m; b != 0; b >>= 1)
+        {
+            if (b & 1)
+                result = result >= m - a ? result - (m - a) : result + a;
+            a = a >= m - a ? a - (m - a) : a + a;
+        }
+        return result;
+#endif
+    }
+
+    constexpr uint64_t pow_mod(uint64_t base, uint64_t exponent, uint64_t m)
+    {
+        uint64_t result = 1;
+        for (base %= m; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+                result = mul_mod(result, base, m);
+            base = mul_mod(base, base, m);
+        }
+        return result;
+    }
+
+    // Miller-Rabin round: is odd n > 2 a strong probable prime to base a?
+    constexpr bool is_strong_probable_prime(uint64_t n, uint64_t a)
+    {
+        a %= n;
+        if (a == 0)
+            return true;
+
+        const int s = std::countr_zero(n - 1);
+        uint64_t x = pow_mod(a, (n - 1) >> s, n);
+        if (x == 1 || x == n - 1)
+            return true;
+
+        for (int r = 1; r < s; ++r)
+        {
+            x = mul_mod(x, x, n);
+            if (x == n - 1)
+                return true;
+        }
+
+        return false;
+    }
+
+    // divisibility by an odd p without division: n % p == 0 <=> n * p^-1 (mod 2^32) <= (2^32 - 1) / p
+    struct OddDivisor
+    {
+        uint32_t p;
+        uint32_t inverse;
+        uint32_t max_quotient;
+    };
+
+    constexpr uint32_t inverse_mod_2_32(uint32_t p)
+    {
+        uint32_t inverse = p; // correct in the lowest 3 bits, each Newton step doubles that
+        for (int i = 0; i < 4; ++i)
+            inverse *= 2 - p * inverse;
+        return inverse;
+    }
+
+    // Miller-Rabin with bases {2, 7, 61} in Montgomery form (R = 2^32) - no divisions in the squaring loops
+    constexpr bool passes_miller_rabin_32(uint32_t n)
+    {
+        const uint32_t inverse = inverse_mod_2_32(n);
+
+        // t * R^-1 mod n for t < n * R
+        auto reduce = [n, inverse](uint64_t t) -> uint32_t {
+            const uint32_t t_high = static_cast<uint32_t>(t >> 32);
+            const uint32_t mn_high = static_cast<uint32_t>((uint64_t{static_cast<uint32_t>(t) * inverse} * n) >> 32);
+            return t_high >= mn_high ? t_high - mn_high : t_high - mn_high + n;
+        };
+
+        const uint32_t one = static_cast<uint32_t>((uint64_t{1} << 32) % n);
+        const uint32_t minus_one = n - one;
+        const int s = std::countr_zero(n - 1);
+        const uint32_t d = (n - 1) >> s;
 
-        for (auto i = 2u; i < n; ++i)
+        for (uint32_t a : std::array<uint32_t, 3>{2, 7, 61})
         {
-            if (n % i == 0)
+            if (a % n == 0)
+                continue;
+
+            uint32_t base = static_cast<uint32_t>((uint64_t{a} << 32) % n);
+            uint32_t x = one;
+            for (uint32_t e = d; e != 0; e >>= 1)
+            {
+                if (e & 1)
+                    x = reduce(uint64_t{x} * base);
+                base = reduce(uint64_t{base} * base);
+            }
+
+            if (x == one || x == minus_one)
+                continue;
+
+            for (int r = 1; r < s && x != minus_one; ++r)
+                x = reduce(uint64_t{x} * x);
+
+            if (x != minus_one)
                 return false;
         }
 
         return true;
     }
 
-    export template <uint32_t N>
-    constexpr std::array<uint32_t, N> get_primes()
+    // deterministic Miller-Rabin for odd n - witnesses {2, 7, 61} are exact below 4'759'123'141 (Jaeschke),
+    // the 7 bases of Sinclair cover the whole 64-bit range
+    constexpr bool passes_miller_rabin(uint64_t n)
+    {
+        if (n <= std::numeric_limits<uint32_t>::max())
+            return passes_miller_rabin_32(static_cast<uint32_t>(n));
+
+        auto passes = [n](uint64_t a) { return is_strong_probable_prime(n, a); };
+        return std::ranges::all_of(std::array<uint64_t, 7>{2, 325, 9375, 28178, 450775, 9780504, 1795265022}, passes);
+    }
+
+    export constexpr bool is_prime(uint64_t n)
+    {
+        if (n < small_prime_limit)
+            return n == 2 || (n % 2 == 1 && (small_primes_bitmap[n / 128] >> (n / 2 % 64) & 1) != 0);
+
+        constexpr std::array<uint64_t, 12> small_divisors = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+        if (std::ranges::any_of(small_divisors, [n](uint64_t p) { return n % p == 0; }))
+            return false;
+
+        return passes_miller_rabin(n);
+    }
+
+    // odd primes below 64 - a number below 67 * 67 that has none of them as a proper divisor is a prime
+    constexpr uint32_t batch_filter_limit = 67 * 67;
+
+    constexpr std::array<OddDivisor, 17> batch_divisors = [] {
+        std::array<OddDivisor, 17> divisors{};
+        size_t count = 0;
+        for (uint32_t p = 3; count < divisors.size(); p += 2)
+        {
+            if (is_prime(p))
+                divisors[count++] = {p, inverse_mod_2_32(p), std::numeric_limits<uint32_t>::max() / p};
+        }
+        return divisors;
+    }();
+
+    enum BatchVerdict : uint8_t
+    {
+        verdict_composite = 0,
+        verdict_prime = 1,
+        verdict_needs_test = 2
+    };
+
+    // trial division of Lanes numbers at once - branch-free multiply/compare over fixed-size blocks,
+    // so the compiler keeps every lane in a vector register
+    template <size_t Lanes>
+    void trial_division_filter(const uint32_t* numbers, uint8_t* verdicts)
+    {
+        std::array<uint32_t, Lanes> has_divisor{};
+
+        for (const OddDivisor& d : batch_divisors)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+                has_divisor[lane] |= static_cast<uint32_t>(numbers[lane] * d.inverse <= d.max_quotient) & static_cast<uint32_t>(numbers[lane] != d.p);
+        }
+
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            const uint32_t n = numbers[lane];
+            const uint32_t is_composite = has_divisor[lane] | static_cast<uint32_t>(n < 2) | static_cast<uint32_t>((n & 1) == 0 && n != 2);
+            const uint32_t is_small = n < batch_filter_limit;
+            verdicts[lane] = static_cast<uint8_t>((1 - is_composite) * (is_small ? verdict_prime : verdict_needs_test));
+        }
+    }
+
+    // out[i] = is_prime(numbers[i]) - small prime factors are filtered for blocks of numbers at once,
+    // only survivors run the Miller-Rabin test
+    export void is_prime_batch(std::span<const uint32_t> numbers, std::span<uint8_t> out)
+    {
+        if (out.size() < numbers.size())
+            throw std::invalid_argument("is_prime_batch: output span is shorter than input");
+
+        constexpr size_t lanes = 16;
+
+        size_t i = 0;
+        for (; i + lanes <= numbers.size(); i += lanes)
+            trial_division_filter<lanes>(numbers.data() + i, out.data() + i);
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (out[j] == verdict_needs_test)
+                out[j] = passes_miller_rabin(numbers[j]);
+        }
+
+        for (; i < numbers.size(); ++i)
+            out[i] = is_prime(numbers[i]);
+    }
+
+    // upper bound of the n-th prime without floating point: p(n) < n * (ln n + ln ln n) for n >= 6 (Rosser),
+    // ln x is over-estimated as 0.7 * bit_width(x)
+    constexpr uint64_t nth_prime_upper_bound(uint64_t n)
     {
+        if (n < 6)
+            return 13;
+
+        auto ln_upper = [](uint64_t x) -> uint64_t { return std::bit_width(x) * 7 / 10 + 1; };
+
+        return n * (ln_upper(n) + ln_upper(ln_upper(n)));
+    }
+
+    // sieve of Eratosthenes over odd numbers processed in segments - near-linear work; one byte per odd number
+    // keeps constant evaluation cheap (no bit arithmetic per crossed out multiple); GCC's default
+    // -fconstexpr-ops-limit (2^25) suffices for N up to about 60'000 - larger tables need a raised
+    // limit (-fconstexpr-ops-limit, clang: -fconstexpr-steps) or come from the tables generated at build time (math_tables.hpp)
+    template <uint32_t N>
+    constexpr std::array<uint32_t, N> sieve_primes()
+    {
+        static_assert(N <= 203'280'221, "primes must fit in uint32_t - there are 203'280'221 primes below 2^32");
+
         std::array<uint32_t, N> primes{};
+        if (N == 0)
+            return primes;
+
+        primes[0] = 2;
+        size_t count = 1;
+
+        constexpr uint32_t segment_size = 1 << 15;
+        const uint64_t limit = nth_prime_upper_bound(N);
+        const uint64_t odd_count = limit / 2; // index i represents odd number 2 * i + 1
+
+        std::vector<uint64_t> base_primes;   // primes p with p * p < limit
+        std::vector<uint64_t> next_multiple; // index of the next odd multiple to cross out
+        bool composite[segment_size] = {};
+
+        for (uint64_t low = 0; low < odd_count && count < N; low += segment_size)
+        {
+            const uint64_t size = std::min<uint64_t>(segment_size, odd_count - low);
+            std::fill(composite, composite + size, false);
+            if (low == 0)
+                composite[0] = true; // 1 is not a prime
+
+            for (size_t j = 0; j < base_primes.size(); ++j)
+            {
+                const uint64_t step = base_primes[j]; // odd multiples of p are 2p apart
+                uint64_t i = next_multiple[j] - low;
+                for (; i < size; i += step)
+                    composite[i] = true;
+                next_multiple[j] = low + i;
+            }
+
+            for (uint64_t i = 0; i < size && count < N; ++i)
+            {
+                if (composite[i])
+                    continue;
 
-        auto primes_view = std::views::iota(2u) | std::views::filter(is_prime) | std::views::take(N);
+                const uint64_t p = 2 * (low + i) + 1;
+                primes[count++] = static_cast<uint32_t>(p);
 
-        std::ranges::copy(primes_view, primes.begin());
+                if (p * p < limit)
+                {
+                    uint64_t multiple = p * p / 2 - low;
+                    for (; multiple < size; multiple += p)
+                        composite[multiple] = true;
+
+                    base_primes.push_back(p);
+                    next_multiple.push_back(low + multiple);
+                }
+            }
+        }
 
         return primes;
     }
 
+    export template <uint32_t N>
+    constexpr std::array<uint32_t, N> get_primes()
+    {
+        return sieve_primes<N>();
+    }
+
+    // unbounded sequence of primes sieved lazily - a segment of odd numbers is sieved only when iteration reaches it,
+    // so primes_view{} | std::views::take(n) costs amortized O(log log p) per prime;
+    // upper_bound_hint (the largest prime expected to be read) sizes the segments for that range
+    export class primes_view : public std::ranges::view_interface<primes_view>
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = uint64_t;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(uint64_t upper_bound_hint)
+                : segment_size_{upper_bound_hint == 0 ? initial_segment_size : std::clamp<uint64_t>(upper_bound_hint / 2 + 1, 64, max_segment_size)}
+                , grow_segments_{upper_bound_hint == 0}
+            {
+            }
+
+            uint64_t operator*() const noexcept
+            {
+                return prime_;
+            }
+
+            iterator& operator++()
+            {
+                while (!next_in_segment())
+                    sieve_next_segment();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator&, std::default_sentinel_t) noexcept
+            {
+                return false;
+            }
+
+        private:
+            static constexpr uint64_t initial_segment_size = 1 << 12;
+            static constexpr uint64_t max_segment_size = 1 << 18; // 32 KiB of bits
+
+            uint64_t prime_ = 2;
+            uint64_t segment_size_ = initial_segment_size;
+            bool grow_segments_ = true;
+
+            // bit i of the segment represents odd number 2 * (low_ + i) + 1
+            uint64_t low_ = 0;
+            uint64_t high_ = 0;
+            uint64_t position_ = 0; // next bit to inspect, relative to low_
+            std::vector<uint64_t> composite_;
+
+            std::vector<uint64_t> base_primes_;   // odd primes below base_limit_
+            std::vector<uint64_t> next_multiple_; // bit of the next odd multiple to cross out
+            uint64_t base_limit_ = 3;
+
+            bool next_in_segment()
+            {
+                for (uint64_t word = position_ / 64; word < composite_.size(); ++word)
+                {
+                    const uint64_t candidates = ~composite_[word] & (~uint64_t{0} << (word == position_ / 64 ? position_ % 64 : 0));
+                    if (candidates == 0)
+                        continue;
+
+                    const uint64_t bit = word * 64 + std::countr_zero(candidates);
+                    if (low_ + bit >= high_)
+                        return false;
+
+                    position_ = bit + 1;
+                    prime_ = 2 * (low_ + bit) + 1;
+                    return true;
+                }
+
+                return false;
+            }
+
+            void sieve_next_segment()
+            {
+                low_ = high_;
+                high_ = low_ + segment_size_;
+                position_ = 0;
+                if (grow_segments_)
+                    segment_size_ = std::min(2 * segment_size_, max_segment_size);
+
+                extend_base_primes(2 * high_ + 1);
+
+                composite_.assign((high_ - low_ + 63) / 64, 0);
+                if (low_ == 0)
+                    composite_[0] = 1; // 1 is not a prime
+
+                for (size_t j = 0; j < base_primes_.size(); ++j)
+                {
+                    uint64_t bit = next_multiple_[j];
+                    for (; bit < high_; bit += base_primes_[j]) // odd multiples of p are 2p apart
+                        composite_[(bit - low_) / 64] |= uint64_t{1} << ((bit - low_) % 64);
+                    next_multiple_[j] = bit;
+                }
+            }
+
+            // makes base_primes_ contain every odd prime p with p * p < limit
+            void extend_base_primes(uint64_t limit)
+            {
+                if (base_limit_ * base_limit_ >= limit)
+                    return;
+
+                const uint64_t new_base_limit = std::max(2 * base_limit_, static_cast<uint64_t>(std::sqrt(static_cast<double>(limit))) + 2);
+
+                std::vector<bool> is_composite(new_base_limit);
+                for (uint64_t p = 3; p < new_base_limit; p += 2)
+                {
+                    if (is_composite[p])
+                        continue;
+
+                    for (uint64_t multiple = p * p; multiple < new_base_limit; multiple += 2 * p)
+                        is_composite[multiple] = true;
+
+                    // a new base prime has p * p >= 2 * low_ + 1, so none of its multiples were skipped
+                    if (p >= base_limit_)
+                    {
+                        base_primes_.push_back(p);
+                        next_multiple_.push_back(p * p / 2);
+                    }
+                }
+
+                base_limit_ = new_base_limit;
+            }
+        };
+
+        primes_view() = default;
+
+        explicit primes_view(uint64_t upper_bound_hint)
+            : upper_bound_hint_{upper_bound_hint}
+        {
+        }
+
+        iterator begin() const
+        {
+            return iterator{upper_bound_hint_};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        uint64_t upper_bound_hint_ = 0;
+    };
+
     export constexpr std::array first_primes = get_primes<100>();
 }
\ No newline at end of file
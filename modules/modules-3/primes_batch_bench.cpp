@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+import Math;
+
+namespace
+{
+    template <typename F>
+    double measure_ms(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char* name, size_t count, double ms, const std::vector<uint8_t>& verdicts)
+    {
+        size_t primes = 0;
+        for (uint8_t verdict : verdicts)
+            primes += verdict;
+
+        std::cout << "  " << name << ": " << ms << " ms, " << count / ms / 1'000.0 << " M numbers/s (primes: " << primes << ")\n";
+    }
+} // namespace
+
+int main()
+{
+    constexpr size_t count = 10'000'000;
+
+    std::mt19937 rnd{42};
+    std::vector<uint32_t> random_numbers(count);
+    for (auto& n : random_numbers)
+        n = rnd();
+
+    std::vector<uint32_t> consecutive_numbers(count);
+    for (uint32_t i = 0; auto& n : consecutive_numbers)
+        n = 1'000'000'000 + i++;
+
+    std::vector<uint8_t> verdicts(count);
+
+    for (const auto& [title, numbers] : {std::pair{"random 32-bit numbers", &random_numbers}, std::pair{"consecutive numbers from 10^9", &consecutive_numbers}})
+    {
+        std::cout << title << "\n";
+
+        double ms = measure_ms([&] {
+            for (size_t i = 0; i < count; ++i)
+                verdicts[i] = Math::Primes::is_prime((*numbers)[i]);
+        });
+        report("is_prime per element", count, ms, verdicts);
+
+        ms = measure_ms([&] { Math::Primes::is_prime_batch(*numbers, verdicts); });
+        report("is_prime_batch     ", count, ms, verdicts);
+    }
+}
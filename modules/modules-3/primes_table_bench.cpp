@@ -0,0 +1,16 @@
+#include <cstdint>
+#include <iostream>
+
+import Math;
+
+// size of the prime table evaluated at compile time - set per target in CMakeLists.txt
+#ifndef PRIMES_TABLE_SIZE
+#define PRIMES_TABLE_SIZE 1000
+#endif
+
+constexpr auto primes_table = Math::Primes::get_primes<PRIMES_TABLE_SIZE>();
+
+int main()
+{
+    std::cout << "primes_table<" << primes_table.size() << ">: last prime = " << primes_table.back() << "\n";
+}
@@ -0,0 +1,180 @@
+#ifndef PRIMES_SENDERS_HPP
+#define PRIMES_SENDERS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+namespace primes
+{
+    namespace details
+    {
+        // one byte per odd number - 256 KiB of sieve per segment fits in L2
+        inline constexpr uint64_t segment_odd_count = 1 << 18;
+        inline constexpr uint64_t segment_length = 2 * segment_odd_count;
+
+        inline uint64_t isqrt(uint64_t n)
+        {
+            uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+            while (root * root > n)
+                --root;
+            while ((root + 1) * (root + 1) <= n)
+                ++root;
+            return root;
+        }
+
+        // odd primes p with p * p < limit
+        inline std::vector<uint32_t> odd_base_primes(uint64_t limit)
+        {
+            const uint64_t max_base = isqrt(limit);
+
+            std::vector<uint8_t> is_composite(max_base + 1);
+            std::vector<uint32_t> base_primes;
+            for (uint64_t p = 3; p <= max_base; p += 2)
+            {
+                if (is_composite[p])
+                    continue;
+
+                base_primes.push_back(static_cast<uint32_t>(p));
+                for (uint64_t multiple = p * p; multiple <= max_base; multiple += 2 * p)
+                    is_composite[multiple] = 1;
+            }
+
+            return base_primes;
+        }
+
+        // calls on_prime(p) for every prime p in [low, high) in increasing order
+        template <typename OnPrime>
+        void sieve_segment(uint64_t low, uint64_t high, std::span<const uint32_t> base_primes, OnPrime&& on_prime)
+        {
+            if (low <= 2 && 2 < high)
+                on_prime(uint64_t{2});
+
+            const uint64_t first_odd = low | 1;
+            if (first_odd >= high)
+                return;
+
+            thread_local std::vector<uint8_t> is_composite;
+            is_composite.assign((high - first_odd + 1) / 2, 0); // index i represents first_odd + 2 * i
+
+            if (first_odd == 1)
+                is_composite[0] = 1;
+
+            for (uint64_t p : base_primes)
+            {
+                if (p * p >= high)
+                    break;
+
+                uint64_t start = std::max(p * p, (first_odd + p - 1) / p * p);
+                if (start % 2 == 0)
+                    start += p;
+
+                for (uint64_t i = (start - first_odd) / 2; i < is_composite.size(); i += p)
+                    is_composite[i] = 1;
+            }
+
+            for (uint64_t i = 0; i < is_composite.size(); ++i)
+            {
+                if (!is_composite[i])
+                    on_prime(first_odd + 2 * i);
+            }
+        }
+
+        struct SieveJob
+        {
+            uint64_t lo;
+            uint64_t hi;
+            std::vector<uint32_t> base_primes;
+
+            SieveJob(uint64_t lo, uint64_t hi)
+                : lo{lo}
+                , hi{std::max(lo, hi)}
+                , base_primes{odd_base_primes(hi)}
+            {
+            }
+
+            static size_t segment_count(uint64_t lo, uint64_t hi)
+            {
+                return hi > lo ? (hi - lo + segment_length - 1) / segment_length : 0;
+            }
+
+            template <typename OnPrime>
+            void sieve(size_t segment, OnPrime&& on_prime) const
+            {
+                const uint64_t low = lo + segment * segment_length;
+                sieve_segment(low, std::min(hi, low + segment_length), base_primes, std::forward<OnPrime>(on_prime));
+            }
+        };
+
+        struct CountJob : SieveJob
+        {
+            std::vector<uint64_t> counts;
+
+            CountJob(uint64_t lo, uint64_t hi)
+                : SieveJob{lo, hi}
+                , counts(segment_count(lo, hi))
+            {
+            }
+        };
+
+        struct EnumerateJob : SieveJob
+        {
+            std::vector<std::vector<uint64_t>> segment_primes;
+            std::vector<size_t> offsets;
+            std::vector<uint64_t> primes;
+
+            EnumerateJob(uint64_t lo, uint64_t hi)
+                : SieveJob{lo, hi}
+                , segment_primes(segment_count(lo, hi))
+            {
+            }
+        };
+    } // namespace details
+
+    // number of primes in [lo, hi) - every sieve segment is one bulk item run on the scheduler,
+    // each item writes only its own slot, so the results are merged in order without locking
+    inline stdexec::sender auto count_primes(stdexec::scheduler auto scheduler, uint64_t lo, uint64_t hi)
+    {
+        const size_t segments = details::SieveJob::segment_count(lo, hi);
+
+        return stdexec::schedule(scheduler)
+            | stdexec::then([lo, hi] { return details::CountJob{lo, hi}; })
+            | stdexec::bulk(segments, [](size_t segment, details::CountJob& job) {
+                  uint64_t count = 0;
+                  job.sieve(segment, [&count](uint64_t) { ++count; });
+                  job.counts[segment] = count;
+              })
+            | stdexec::then([](auto&& job) { return std::reduce(job.counts.begin(), job.counts.end(), uint64_t{0}); });
+    }
+
+    // primes in [lo, hi) in increasing order - segments are sieved in parallel, then every segment
+    // copies its primes to an offset known from the prefix sum of the segment sizes
+    inline stdexec::sender auto enumerate_primes(stdexec::scheduler auto scheduler, uint64_t lo, uint64_t hi)
+    {
+        const size_t segments = details::SieveJob::segment_count(lo, hi);
+
+        return stdexec::schedule(scheduler)
+            | stdexec::then([lo, hi] { return details::EnumerateJob{lo, hi}; })
+            | stdexec::bulk(segments, [](size_t segment, details::EnumerateJob& job) {
+                  auto& primes = job.segment_primes[segment];
+                  job.sieve(segment, [&primes](uint64_t p) { primes.push_back(p); });
+              })
+            | stdexec::then([](auto&& job) {
+                  job.offsets.resize(job.segment_primes.size() + 1);
+                  std::transform_inclusive_scan(job.segment_primes.begin(), job.segment_primes.end(), job.offsets.begin() + 1, std::plus{},
+                      [](const auto& primes) { return primes.size(); });
+                  job.primes.resize(job.offsets.back());
+                  return std::move(job);
+              })
+            | stdexec::bulk(segments, [](size_t segment, details::EnumerateJob& job) {
+                  std::ranges::copy(job.segment_primes[segment], job.primes.begin() + job.offsets[segment]);
+              })
+            | stdexec::then([](auto&& job) { return std::move(job.primes); });
+    }
+} // namespace primes
+
+#endif
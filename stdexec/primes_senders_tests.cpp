@@ -0,0 +1,98 @@
+#include "primes_senders.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <format>
+#include <ranges>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    bool is_prime_slow(uint64_t n)
+    {
+        if (n < 2)
+            return false;
+
+        for (uint64_t d = 2; d * d <= n; ++d)
+        {
+            if (n % d == 0)
+                return false;
+        }
+
+        return true;
+    }
+} // namespace
+
+TEST_CASE("count_primes & enumerate_primes", "[stdexec][primes]")
+{
+    exec::static_thread_pool thread_pool{4};
+    stdexec::scheduler auto scheduler = thread_pool.get_scheduler();
+
+    SECTION("pi(x) for powers of 10")
+    {
+        auto [pi_1e6] = stdexec::sync_wait(primes::count_primes(scheduler, 0, 1'000'000)).value();
+        auto [pi_1e8] = stdexec::sync_wait(primes::count_primes(scheduler, 0, 100'000'000)).value();
+
+        CHECK(pi_1e6 == 78'498);
+        CHECK(pi_1e8 == 5'761'455);
+    }
+
+    SECTION("interval spanning many segments matches trial division")
+    {
+        const uint64_t lo = 1'000'000'000'000 - 3'000'000;
+        const uint64_t hi = 1'000'000'000'000;
+
+        auto [primes] = stdexec::sync_wait(primes::enumerate_primes(scheduler, lo, hi)).value();
+        auto [count] = stdexec::sync_wait(primes::count_primes(scheduler, lo, hi)).value();
+
+        REQUIRE(primes.size() == count);
+        CHECK(std::ranges::is_sorted(primes));
+        CHECK(std::ranges::all_of(primes, [&](uint64_t p) { return lo <= p && p < hi; }));
+        CHECK(std::ranges::all_of(primes | std::views::take(100), is_prime_slow));
+        CHECK(primes.back() == 999'999'999'989);
+    }
+
+    SECTION("small and empty intervals")
+    {
+        auto [first_primes] = stdexec::sync_wait(primes::enumerate_primes(scheduler, 0, 30)).value();
+        CHECK(first_primes == std::vector<uint64_t>{2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+
+        auto [none] = stdexec::sync_wait(primes::enumerate_primes(scheduler, 24, 29)).value();
+        CHECK(none.empty());
+
+        auto [empty_count] = stdexec::sync_wait(primes::count_primes(scheduler, 100, 100)).value();
+        CHECK(empty_count == 0);
+    }
+}
+
+TEST_CASE("count_primes - scaling with threads", "[.][benchmark]")
+{
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    for (unsigned threads : thread_counts)
+    {
+        exec::static_thread_pool thread_pool{threads};
+        stdexec::scheduler auto scheduler = thread_pool.get_scheduler();
+
+        BENCHMARK(std::format("count_primes [0, 10^9) - {} threads", threads))
+        {
+            auto [count] = stdexec::sync_wait(primes::count_primes(scheduler, 0, 1'000'000'000)).value();
+            return count;
+        };
+
+        BENCHMARK(std::format("enumerate_primes [0, 10^8) - {} threads", threads))
+        {
+            auto [primes] = stdexec::sync_wait(primes::enumerate_primes(scheduler, 0, 100'000'000)).value();
+            return primes.size();
+        };
+    }
+}
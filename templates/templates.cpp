@@ -1,6 +1,21 @@
+#include <async_log.hpp>
+#include <binary_log.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <function.hpp>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <array>
 
@@ -151,6 +166,229 @@ TEST_CASE("structural types as NTTP")
     REQUIRE(calc_gross_price<vat_es>(100.0) == 120.0);
 }
 
+// fixed-point prices - the rate must have at most 4 decimal places (whole basis points)
+template <Tax Vat>
+constexpr int64_t calc_gross_price_cents(int64_t net_cents)
+{
+    constexpr int64_t basis_points = static_cast<int64_t>(Vat.value * 10'000 + 0.5);
+    static_assert(basis_points / 10'000.0 == Vat.value, "VAT rate must be a whole number of basis points");
+
+    // tax rounded half away from zero
+    return net_cents + (net_cents * basis_points + (net_cents < 0 ? -5'000 : 5'000)) / 10'000;
+}
+
+namespace BatchPricing
+{
+    // fixed trip count & no aliasing (__restrict) let the compiler vectorize the loop at -O2
+    constexpr size_t lanes = 32;
+
+    template <typename TPrice, typename PriceFunction>
+    void apply_to_block(const TPrice* __restrict net_prices, TPrice* __restrict gross_prices, PriceFunction price)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+            gross_prices[lane] = price(net_prices[lane]);
+    }
+
+    // gross_prices must not overlap net_prices
+    template <typename TPrice, typename PriceFunction>
+    void apply_in_blocks(std::span<const TPrice> net_prices, std::span<TPrice> gross_prices, PriceFunction price)
+    {
+        assert(net_prices.size() == gross_prices.size());
+        assert(net_prices.empty() || gross_prices.data() + gross_prices.size() <= net_prices.data()
+            || net_prices.data() + net_prices.size() <= gross_prices.data());
+
+        size_t row = 0;
+        for (; row + lanes <= net_prices.size(); row += lanes)
+            apply_to_block(net_prices.data() + row, gross_prices.data() + row, price);
+
+        for (; row < net_prices.size(); ++row)
+            gross_prices[row] = price(net_prices[row]);
+    }
+
+    // 64-bit integer division has no vector instruction - with vector int64 <-> double conversions (AVX-512DQ)
+    // the tax is divided in double precision; exact while |net_cents * basis_points| < 2^53, i.e. for
+    // |net_cents| < 2^40 with rates below 81.92% (8192 basis points); higher rates and other targets
+    // (where the conversions cost more than they save) use calc_gross_price_cents
+    template <Tax Vat>
+    constexpr int64_t gross_price_cents(int64_t net_cents)
+    {
+#if defined(__AVX512DQ__)
+        constexpr int64_t basis_points = static_cast<int64_t>(Vat.value * 10'000 + 0.5);
+
+        if constexpr (basis_points < 8'192)
+        {
+            const double tax = static_cast<double>(net_cents * basis_points) / 10'000.0;
+            return net_cents + static_cast<int64_t>(tax + (tax < 0.0 ? -0.5 : 0.5));
+        }
+#endif
+        return calc_gross_price_cents<Vat>(net_cents);
+    }
+
+    template <std::array TaxTable>
+    constexpr auto tax_rates = [] {
+        std::array<double, TaxTable.size()> rates{};
+        for (size_t i = 0; i < TaxTable.size(); ++i)
+            rates[i] = TaxTable[i].value;
+        return rates;
+    }();
+} // namespace BatchPricing
+
+// batch versions of calc_gross_price - gross_prices must not overlap net_prices
+template <Tax Vat>
+void calc_gross_prices(std::span<const double> net_prices, std::span<double> gross_prices)
+{
+    BatchPricing::apply_in_blocks(net_prices, gross_prices, [](double net_price) {
+        return calc_gross_price<Vat>(net_price);
+    });
+}
+
+template <Tax Vat>
+void calc_gross_prices(std::span<const int64_t> net_cents, std::span<int64_t> gross_cents)
+{
+    BatchPricing::apply_in_blocks(net_cents, gross_cents, [](int64_t net_price) {
+        return BatchPricing::gross_price_cents<Vat>(net_price);
+    });
+}
+
+// per-row tax class - an index into TaxTable; a plain indexed loop - vector select or gather
+// of the rate measured slower (the loop is bound by loading the prices)
+template <std::array TaxTable>
+void calc_gross_prices(std::span<const double> net_prices, std::span<const uint8_t> tax_classes, std::span<double> gross_prices)
+{
+    assert(tax_classes.size() == net_prices.size() && gross_prices.size() == net_prices.size());
+
+    for (size_t row = 0; row < net_prices.size(); ++row)
+    {
+        assert(tax_classes[row] < TaxTable.size());
+        gross_prices[row] = net_prices[row] + net_prices[row] * BatchPricing::tax_rates<TaxTable>[tax_classes[row]];
+    }
+}
+
+namespace
+{
+    constexpr std::array tax_table_pl{Tax{0.23}, Tax{0.08}, Tax{0.05}, Tax{0.0}};
+
+    struct PriceList
+    {
+        std::vector<double> net_prices;
+        std::vector<int64_t> net_cents;
+        std::vector<uint8_t> tax_classes;
+
+        explicit PriceList(size_t size)
+        {
+            std::mt19937_64 rnd{42};
+            std::uniform_int_distribution<int64_t> cents{-1'000'000, 100'000'000};
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                net_cents.push_back(i % 10 == 0 ? cents(rnd) / 100 * 100 + 50 : cents(rnd)); // some ties x.5 cents of tax
+                net_prices.push_back(static_cast<double>(net_cents.back()) / 100.0);
+                tax_classes.push_back(static_cast<uint8_t>(rnd() % tax_table_pl.size()));
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE("batch gross prices")
+{
+    constexpr Tax vat_pl{0.23};
+
+    static_assert(calc_gross_price_cents<vat_pl>(10'000) == 12'300);
+    static_assert(calc_gross_price_cents<vat_pl>(2) == 2);    // 0.46 cents of tax
+    static_assert(calc_gross_price_cents<vat_pl>(50) == 62);  // 11.5 cents of tax
+    static_assert(calc_gross_price_cents<vat_pl>(-50) == -62);
+
+    const PriceList prices{1'000 + 7}; // blocks & a tail
+
+    SECTION("doubles - same as calc_gross_price")
+    {
+        std::vector<double> gross_prices(prices.net_prices.size());
+        calc_gross_prices<vat_pl>(prices.net_prices, gross_prices);
+
+        for (size_t i = 0; i < gross_prices.size(); ++i)
+            REQUIRE(gross_prices[i] == calc_gross_price<vat_pl>(prices.net_prices[i]));
+    }
+
+    SECTION("cents - same as calc_gross_price_cents")
+    {
+        std::vector<int64_t> gross_cents(prices.net_cents.size());
+        calc_gross_prices<vat_pl>(prices.net_cents, gross_cents);
+
+        for (size_t i = 0; i < gross_cents.size(); ++i)
+            REQUIRE(gross_cents[i] == calc_gross_price_cents<vat_pl>(prices.net_cents[i]));
+
+        constexpr Tax high_rate{0.95}; // above 8192 basis points - the integer formula
+        const std::vector<int64_t> large_net_cents(100, (int64_t{1} << 40) - 1);
+        std::vector<int64_t> large_gross_cents(large_net_cents.size());
+        calc_gross_prices<high_rate>(large_net_cents, large_gross_cents);
+
+        REQUIRE(large_gross_cents.back() == calc_gross_price_cents<high_rate>(large_net_cents.back()));
+    }
+
+    SECTION("tax class per row")
+    {
+        std::vector<double> gross_prices(prices.net_prices.size());
+        calc_gross_prices<tax_table_pl>(prices.net_prices, prices.tax_classes, gross_prices);
+
+        for (size_t i = 0; i < gross_prices.size(); ++i)
+        {
+            const double rate = tax_table_pl[prices.tax_classes[i]].value;
+            REQUIRE(gross_prices[i] == prices.net_prices[i] + prices.net_prices[i] * rate);
+        }
+    }
+}
+
+TEST_CASE("batch gross prices - vs scalar loop", "[.][benchmark]")
+{
+    constexpr Tax vat_pl{0.23};
+
+    const PriceList prices{16 * 1'024}; // in cache - at millions of rows all loops are bound by memory bandwidth
+    std::vector<double> gross_prices(prices.net_prices.size());
+    std::vector<int64_t> gross_cents(prices.net_cents.size());
+
+    BENCHMARK("doubles - scalar loop")
+    {
+        for (size_t i = 0; i < prices.net_prices.size(); ++i)
+            gross_prices[i] = calc_gross_price<vat_pl>(prices.net_prices[i]);
+        return gross_prices.back();
+    };
+
+    BENCHMARK("doubles - calc_gross_prices")
+    {
+        calc_gross_prices<vat_pl>(prices.net_prices, gross_prices);
+        return gross_prices.back();
+    };
+
+    BENCHMARK("cents - scalar loop")
+    {
+        for (size_t i = 0; i < prices.net_cents.size(); ++i)
+            gross_cents[i] = calc_gross_price_cents<vat_pl>(prices.net_cents[i]);
+        return gross_cents.back();
+    };
+
+    BENCHMARK("cents - calc_gross_prices")
+    {
+        calc_gross_prices<vat_pl>(prices.net_cents, gross_cents);
+        return gross_cents.back();
+    };
+
+    BENCHMARK("tax classes - scalar loop")
+    {
+        for (size_t i = 0; i < prices.net_prices.size(); ++i)
+        {
+            const double rate = tax_table_pl[prices.tax_classes[i]].value;
+            gross_prices[i] = prices.net_prices[i] + prices.net_prices[i] * rate;
+        }
+        return gross_prices.back();
+    };
+
+    BENCHMARK("tax classes - calc_gross_prices")
+    {
+        calc_gross_prices<tax_table_pl>(prices.net_prices, prices.tax_classes, gross_prices);
+        return gross_prices.back();
+    };
+}
+
 template <size_t N>
 struct StaticString
 {
@@ -170,13 +408,49 @@ struct StaticString
     }
 };
 
-template <StaticString LoggerName>
+using helpers::log::Level;
+
+// messages below MinLevel are removed at compile time - the rest is formatted on the calling thread
+// and handed to the asynchronous backend (per-thread lock-free ring, written to stdout in batches)
+template <StaticString LoggerName, Level MinLevel = Level::info>
 struct Logger
 {
 public:
+    template <Level MessageLevel>
+    static constexpr bool is_enabled = MessageLevel >= MinLevel;
+
     void log(std::string_view msg)
     {
-        std::cout << LoggerName << ": " << msg << "\n";
+        log<Level::info>("{}", msg);
+    }
+
+    template <Level MessageLevel, typename... TArgs>
+    void log(std::format_string<TArgs...> fmt, TArgs&&... args)
+    {
+        if constexpr (is_enabled<MessageLevel>)
+        {
+            thread_local std::string line;
+
+            line.clear();
+            std::format_to(std::back_inserter(line), "[{}] {}: ", helpers::log::to_string(MessageLevel), LoggerName.text);
+            std::format_to(std::back_inserter(line), fmt, std::forward<TArgs>(args)...);
+            line.push_back('\n');
+
+            helpers::log::AsyncBackend::standard_output().write(line);
+        }
+    }
+
+    // only the call site id and raw argument bytes are written - decoded offline by binary_log_decoder
+    template <Level MessageLevel, helpers::log::FixedString Format, typename... TArgs>
+    void log_binary(helpers::log::BinaryLog& binary_log, const TArgs&... args)
+    {
+        if constexpr (is_enabled<MessageLevel>)
+            binary_log.write<MessageLevel, helpers::log::FixedString<sizeof(LoggerName.text)>{LoggerName.text}, Format>(args...);
+    }
+
+    static void flush()
+    {
+        helpers::log::AsyncBackend::standard_output().flush();
     }
 };
 
@@ -185,10 +459,41 @@ TEST_CASE("strings as NTTP")
     StaticString str("text");
 
     Logger<"main_logger"> logger_1;
-    Logger<"low_priority_logger"> logger_2;
+    Logger<"low_priority_logger", Level::warning> logger_2;
 
     logger_1.log("Start");
-    logger_2.log("Start");
+    logger_2.log("Start"); // filtered out
+
+    logger_1.log<Level::debug>("filtered out: {}", 42);
+    logger_2.log<Level::error>("error code: {}", 42);
+
+    static_assert(decltype(logger_1)::is_enabled<Level::info>);
+    static_assert(!decltype(logger_2)::is_enabled<Level::info>);
+
+    Logger<"main_logger">::flush();
+}
+
+TEST_CASE("binary log with deferred formatting")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+
+    {
+        helpers::log::BinaryLog binary_log{{.fd = fileno(file)}};
+
+        Logger<"main_logger", Level::warning> logger;
+        logger.log_binary<Level::info, "filtered out: {}">(binary_log, 1);
+        logger.log_binary<Level::error, "error code: {} in {}">(binary_log, 42, "templates.cpp"s);
+    }
+
+    std::string content(4096, '\0');
+    std::rewind(file);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+
+    std::ostringstream text;
+    helpers::log::decode_binary_log(content, text);
+    REQUIRE(text.str() == "[error] main_logger: error code: 42 in templates.cpp\n");
 }
 
 ///////////////////////////////////////////
@@ -356,11 +661,15 @@ TEST_CASE("default constructor for lambda")
 
 //////////////////////////////////////////////////////
 
+// deferred call stored inline (no allocation) - callers with the same result type can share a container
+template <size_t Capacity = helpers::default_function_capacity>
 auto create_caller(auto f, auto... args)
 {
-   return [f, ...args = std::move(args)]() -> decltype(auto) {
+    auto caller = [f, ...args = std::move(args)]() -> decltype(auto) {
         return f(args...);
-   }; 
+    };
+
+    return helpers::unique_function<std::invoke_result_t<decltype(caller)&>(), Capacity>{std::move(caller)};
 }
 
 TEST_CASE("lambda - capturing argument pack")
@@ -368,4 +677,12 @@ TEST_CASE("lambda - capturing argument pack")
     auto f = create_caller(std::plus<int>{}, 3, 5);
 
     REQUIRE(f() == 8);
+
+    std::vector<helpers::unique_function<int()>> callers;
+    callers.push_back(std::move(f));
+    callers.push_back(create_caller(add_int, 30, 90));
+    callers.push_back(create_caller([](const auto& ptr) { return *ptr; }, std::make_unique<int>(42))); // move-only argument
+
+    REQUIRE(callers[1]() == 120);
+    REQUIRE(callers[2]() == 42);
 }